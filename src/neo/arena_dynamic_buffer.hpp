@@ -0,0 +1,151 @@
+#pragma once
+
+#include "./const_buffer.hpp"
+#include "./mutable_buffer.hpp"
+
+#include <neo/assert.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <memory_resource>
+#include <utility>
+
+namespace neo {
+
+/**
+ * A dynamic buffer that draws its storage from a memory resource. It is meant
+ * to be used with a monotonic arena (such as
+ * `std::pmr::monotonic_buffer_resource`) that lives as long as a single request
+ * or task, and whose memory is released all at once when that is over.
+ *
+ * `consume()` and `shrink()` only move the bounds of the data. When `grow()`
+ * runs out of room, the data is moved to the front of the storage if that makes
+ * enough room, and is otherwise moved into a new, larger allocation from the
+ * resource. Storage that is no longer used is deallocated with the resource,
+ * which a monotonic arena ignores, so the buffer does not leak when it uses any
+ * other resource (such as the default one).
+ *
+ * The buffer must not outlive its memory resource.
+ */
+class arena_dynamic_buffer {
+    std::pmr::memory_resource* _resource;
+
+    std::byte*  _data     = nullptr;
+    std::size_t _capacity = 0;
+    std::size_t _begin    = 0;
+    std::size_t _size     = 0;
+
+    void _release() noexcept {
+        if (_data != nullptr) {
+            _resource->deallocate(_data, _capacity);
+            _data = nullptr;
+        }
+    }
+
+public:
+    /// The smallest allocation that the buffer will make from its resource
+    static constexpr std::size_t min_allocation = 1024;
+
+    explicit arena_dynamic_buffer(
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept
+        : _resource(resource) {}
+
+    arena_dynamic_buffer(arena_dynamic_buffer&& o) noexcept
+        : _resource(o._resource)
+        , _data(std::exchange(o._data, nullptr))
+        , _capacity(std::exchange(o._capacity, 0))
+        , _begin(std::exchange(o._begin, 0))
+        , _size(std::exchange(o._size, 0)) {}
+
+    arena_dynamic_buffer& operator=(arena_dynamic_buffer&& o) noexcept {
+        if (this == &o) {
+            return *this;
+        }
+        _release();
+        _resource = o._resource;
+        _data     = std::exchange(o._data, nullptr);
+        _capacity = std::exchange(o._capacity, 0);
+        _begin    = std::exchange(o._begin, 0);
+        _size     = std::exchange(o._size, 0);
+        return *this;
+    }
+
+    ~arena_dynamic_buffer() { _release(); }
+
+    std::pmr::memory_resource* resource() const noexcept { return _resource; }
+
+    std::size_t size() const noexcept { return _size; }
+    std::size_t max_size() const noexcept { return std::numeric_limits<std::size_t>::max(); }
+    std::size_t capacity() const noexcept { return _capacity - _begin; }
+
+    mutable_buffer data(std::size_t pos, std::size_t size_) noexcept {
+        neo_assert(expects,
+                   pos + size_ <= size(),
+                   "Cannot read more bytes than are contained in a dynamic buffer",
+                   pos,
+                   size_,
+                   this->size());
+        return mutable_buffer(_data + _begin + pos, size_);
+    }
+
+    const_buffer data(std::size_t pos, std::size_t size_) const noexcept {
+        neo_assert(expects,
+                   pos + size_ <= size(),
+                   "Cannot read more bytes than are contained in a dynamic buffer",
+                   pos,
+                   size_,
+                   this->size());
+        return const_buffer(_data + _begin + pos, size_);
+    }
+
+    mutable_buffer grow(std::size_t n) {
+        if (_capacity - _begin - _size < n) {
+            if (_capacity - _size >= n && _begin != 0) {
+                // Shift the data down to make room
+                std::memmove(_data, _data + _begin, _size);
+            } else {
+                const auto new_cap = (std::max)({_capacity * 2, _size + n, min_allocation});
+                auto       new_data = static_cast<std::byte*>(_resource->allocate(new_cap));
+                if (_size != 0) {
+                    std::memcpy(new_data, _data + _begin, _size);
+                }
+                _release();
+                _data     = new_data;
+                _capacity = new_cap;
+            }
+            _begin = 0;
+        }
+        const auto prev_size = _size;
+        _size += n;
+        return data(prev_size, n);
+    }
+
+    void shrink(std::size_t n) noexcept {
+        neo_assert(expects,
+                   n <= size(),
+                   "Cannot shrink a dynamic buffer below its own size",
+                   n,
+                   this->size());
+        _size -= n;
+        if (_size == 0) {
+            _begin = 0;
+        }
+    }
+
+    void consume(std::size_t n) noexcept {
+        neo_assert(expects,
+                   n <= size(),
+                   "Cannot consume more bytes than are contained in a dynamic buffer",
+                   n,
+                   this->size());
+        _begin += n;
+        _size -= n;
+        if (_size == 0) {
+            _begin = 0;
+        }
+    }
+};
+
+}  // namespace neo
@@ -0,0 +1,112 @@
+#include <neo/arena_dynamic_buffer.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/buffer_algorithm/compare.hpp>
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/dynamic_buffer.hpp>
+#include <neo/dynbuf_io.hpp>
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+
+NEO_TEST_CONCEPT(neo::dynamic_buffer<neo::arena_dynamic_buffer>);
+
+namespace {
+
+/// Counts allocations and deallocations passed on to an upstream resource
+class counting_resource : public std::pmr::memory_resource {
+    // Releases anything that is left over when the test ends
+    std::pmr::monotonic_buffer_resource _upstream;
+
+public:
+    std::size_t n_allocs   = 0;
+    std::size_t n_deallocs = 0;
+
+private:
+    void* do_allocate(std::size_t size, std::size_t align) override {
+        ++n_allocs;
+        return _upstream.allocate(size, align);
+    }
+    void do_deallocate(void* p, std::size_t size, std::size_t align) override {
+        ++n_deallocs;
+        _upstream.deallocate(p, size, align);
+    }
+    bool do_is_equal(const memory_resource& o) const noexcept override { return this == &o; }
+};
+
+}  // namespace
+
+TEST_CASE("Grow and consume an arena buffer") {
+    counting_resource         counter;
+    neo::arena_dynamic_buffer buf{&counter};
+    CHECK(buf.capacity() == 0);
+
+    buf.grow(10);
+    CHECK(buf.capacity() == neo::arena_dynamic_buffer::min_allocation);
+    CHECK(counter.n_allocs == 1);
+    neo::buffer_copy(buf.data(0, 10), neo::as_buffer("0123456789", 10));
+
+    // Consuming and shrinking only move the bounds of the data
+    buf.consume(4);
+    buf.shrink(2);
+    CHECK(buf.size() == 4);
+    CHECK(std::string_view(buf.data(0, 4)) == "4567");
+    CHECK(counter.n_allocs == 1);
+
+    // Room at the front is reclaimed before asking for more memory
+    buf.grow(1020);
+    CHECK(counter.n_allocs == 1);
+    CHECK(std::string_view(buf.data(0, 4)) == "4567");
+
+    buf.grow(1);
+    CHECK(counter.n_allocs == 2);
+    CHECK(buf.capacity() == 2048);
+    CHECK(std::string_view(buf.data(0, 4)) == "4567");
+    // The old storage is given back to the resource
+    CHECK(counter.n_deallocs == 1);
+}
+
+TEST_CASE("An arena buffer gives its storage back to a general resource") {
+    counting_resource counter;
+    {
+        neo::arena_dynamic_buffer buf{&counter};
+        for (int i = 0; i < 10; ++i) {
+            buf.grow(1000);
+        }
+        neo::arena_dynamic_buffer other{&counter};
+        other.grow(10);
+        other = std::move(buf);
+        CHECK(other.size() == 10000);
+    }
+    CHECK(counter.n_allocs > 1);
+    CHECK(counter.n_deallocs == counter.n_allocs);
+}
+
+TEST_CASE("Parse a request through a monotonic arena") {
+    counting_resource                   counter;
+    std::pmr::monotonic_buffer_resource arena{&counter};
+
+    std::string expect;
+    {
+        neo::dynbuf_io<neo::arena_dynamic_buffer> io{neo::arena_dynamic_buffer{&arena}};
+        for (int i = 0; i < 2000; ++i) {
+            auto word = std::to_string(i) + " ";
+            neo::buffer_copy(io, neo::as_buffer(word));
+            expect += word;
+            if (i % 3 == 0) {
+                io.consume(io.available());
+                expect.clear();
+            }
+        }
+        CHECK(neo::buffer_equal(io.next(io.available()), neo::as_buffer(expect)));
+    }
+    // The arena ignores deallocations, so nothing was freed individually
+    CHECK(counter.n_deallocs == 0);
+    arena.release();
+    CHECK(counter.n_deallocs == counter.n_allocs);
+}
@@ -0,0 +1,329 @@
+#pragma once
+
+#include "./buffer_range.hpp"
+#include "./buffer_sink.hpp"
+#include "./buffer_source.hpp"
+
+#include <neo/assert.hpp>
+#include <neo/fwd.hpp>
+#include <neo/ref_member.hpp>
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace neo {
+
+namespace detail {
+
+// clang-format off
+template <typename T>
+concept has_member_co_await = requires(T&& t) { NEO_FWD(t).operator co_await(); };
+
+template <typename T>
+concept direct_awaiter =
+    requires(T& t, std::coroutine_handle<> h) {
+        { t.await_ready() } -> simple_boolean;
+        t.await_suspend(h);
+        t.await_resume();
+    };
+// clang-format on
+
+template <typename T>
+decltype(auto) get_awaiter(T&& t) noexcept {
+    if constexpr (has_member_co_await<T>) {
+        return NEO_FWD(t).operator co_await();
+    } else {
+        return NEO_FWD(t);
+    }
+}
+
+}  // namespace detail
+
+/**
+ * An object that can be the operand of `co_await`: either an awaiter itself, or
+ * an object with a member `operator co_await()` that returns one.
+ */
+template <typename T>
+concept awaitable = detail::direct_awaiter<
+    std::remove_reference_t<decltype(detail::get_awaiter(std::declval<T>()))>>;
+
+/// The type of a `co_await` expression on an object of type `T`
+template <awaitable T>
+using await_result_t = decltype(detail::get_awaiter(std::declval<T>()).await_resume());
+
+// clang-format off
+/**
+ * An "async_buffer_source" is the asynchronous counterpart of buffer_source:
+ * `next()` returns an awaitable that gives a buffer_range once data is
+ * available (or an empty range at the end of the input). `consume()` is not
+ * awaited.
+ */
+template <typename T>
+concept async_buffer_source =
+    requires (T source, std::size_t size) {
+        { source.next(size) } -> awaitable;
+        requires buffer_range<await_result_t<decltype(source.next(size))>>;
+        { source.consume(size) } noexcept;
+    };
+
+/**
+ * An "async_buffer_sink" is the asynchronous counterpart of buffer_sink:
+ * `prepare()` returns an awaitable that gives a mutable_buffer_range once there
+ * is room for output. `commit()` is not awaited.
+ */
+template <typename T>
+concept async_buffer_sink =
+    requires (T sink, std::size_t size) {
+        { sink.prepare(size) } -> awaitable;
+        requires mutable_buffer_range<await_result_t<decltype(sink.prepare(size))>>;
+        sink.commit(size);
+    };
+// clang-format on
+
+template <typename T>
+concept async_buffer_input = async_buffer_source<T> || buffer_input<T>;
+
+template <typename T>
+concept async_buffer_output = async_buffer_sink<T> || buffer_output<T>;
+
+/**
+ * An awaitable that holds a value which is available immediately. Awaiting it
+ * never suspends.
+ */
+template <typename T>
+class ready_awaitable {
+    T _value;
+
+public:
+    constexpr explicit ready_awaitable(T&& v) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : _value(NEO_FWD(v)) {}
+
+    constexpr bool await_ready() const noexcept { return true; }
+    constexpr void await_suspend(std::coroutine_handle<>) const noexcept {}
+    constexpr T    await_resume() noexcept(std::is_nothrow_move_constructible_v<T>) {
+        return std::move(_value);
+    }
+};
+
+template <typename T>
+explicit ready_awaitable(T &&) -> ready_awaitable<T>;
+
+/**
+ * Present a buffer_source as an async_buffer_source whose data is always ready.
+ */
+template <buffer_source Source>
+class ready_buffer_source {
+    [[no_unique_address]] wrap_ref_member_t<Source> _source;
+
+public:
+    constexpr explicit ready_buffer_source(Source&& s) noexcept
+        : _source(NEO_FWD(s)) {}
+
+    NEO_DECL_UNREF_GETTER(source, _source);
+
+    constexpr auto next(std::size_t n) { return ready_awaitable(source().next(n)); }
+    constexpr void consume(std::size_t n) noexcept { source().consume(n); }
+};
+
+template <typename S>
+explicit ready_buffer_source(S &&) -> ready_buffer_source<S>;
+
+/**
+ * Present a buffer_sink as an async_buffer_sink that always has room.
+ */
+template <buffer_sink Sink>
+class ready_buffer_sink {
+    [[no_unique_address]] wrap_ref_member_t<Sink> _sink;
+
+public:
+    constexpr explicit ready_buffer_sink(Sink&& s) noexcept
+        : _sink(NEO_FWD(s)) {}
+
+    NEO_DECL_UNREF_GETTER(sink, _sink);
+
+    constexpr auto prepare(std::size_t n) { return ready_awaitable(sink().prepare(n)); }
+    constexpr void commit(std::size_t n) { sink().commit(n); }
+};
+
+template <typename S>
+explicit ready_buffer_sink(S &&) -> ready_buffer_sink<S>;
+
+template <async_buffer_input In>
+constexpr decltype(auto) ensure_async_buffer_source(In&& in) noexcept {
+    if constexpr (async_buffer_source<In>) {
+        return In(NEO_FWD(in));
+    } else {
+        return ready_buffer_source(ensure_buffer_source(NEO_FWD(in)));
+    }
+}
+
+template <async_buffer_output Out>
+constexpr decltype(auto) ensure_async_buffer_sink(Out&& out) noexcept {
+    if constexpr (async_buffer_sink<Out>) {
+        return Out(NEO_FWD(out));
+    } else {
+        return ready_buffer_sink(ensure_buffer_sink(NEO_FWD(out)));
+    }
+}
+
+template <typename T = void>
+class task;
+
+namespace detail {
+
+class task_promise_base {
+    std::coroutine_handle<> _continuation = std::noop_coroutine();
+    std::exception_ptr      _error;
+
+    struct final_awaiter {
+        bool await_ready() const noexcept { return false; }
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) const noexcept {
+            // Symmetric transfer back to whoever awaited us, so that long chains
+            // of synchronously-completing tasks do not grow the stack
+            return h.promise()._continuation;
+        }
+        void await_resume() const noexcept {}
+    };
+
+public:
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    final_awaiter       final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception() noexcept { _error = std::current_exception(); }
+
+    void set_continuation(std::coroutine_handle<> h) noexcept { _continuation = h; }
+
+    void rethrow_if_error() const {
+        if (_error) {
+            std::rethrow_exception(_error);
+        }
+    }
+};
+
+template <typename T>
+class task_promise : public task_promise_base {
+    std::optional<T> _value;
+
+public:
+    task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U&& v) {
+        _value.emplace(NEO_FWD(v));
+    }
+
+    T result() {
+        rethrow_if_error();
+        return std::move(*_value);
+    }
+};
+
+template <>
+class task_promise<void> : public task_promise_base {
+public:
+    task<void> get_return_object() noexcept;
+
+    void return_void() noexcept {}
+    void result() const { rethrow_if_error(); }
+};
+
+}  // namespace detail
+
+/**
+ * A lazily-started coroutine that produces a `T`. The coroutine does not run
+ * until the task is awaited (or `start()`ed), and it resumes its awaiter when
+ * it completes. Exceptions that escape the coroutine are rethrown to the
+ * awaiter.
+ *
+ * This is the return type of the async buffer algorithms.
+ */
+template <typename T>
+class [[nodiscard]] task {
+public:
+    using promise_type = detail::task_promise<T>;
+
+private:
+    std::coroutine_handle<promise_type> _coro;
+
+    friend promise_type;
+    explicit task(std::coroutine_handle<promise_type> h) noexcept
+        : _coro(h) {}
+
+    struct awaiter {
+        std::coroutine_handle<promise_type> coro;
+
+        bool await_ready() const noexcept { return coro.done(); }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> cont) const noexcept {
+            coro.promise().set_continuation(cont);
+            return coro;
+        }
+
+        T await_resume() const { return coro.promise().result(); }
+    };
+
+public:
+    task() = default;
+
+    task(task&& o) noexcept
+        : _coro(std::exchange(o._coro, nullptr)) {}
+
+    task& operator=(task&& o) noexcept {
+        if (this != &o) {
+            if (_coro) {
+                _coro.destroy();
+            }
+            _coro = std::exchange(o._coro, nullptr);
+        }
+        return *this;
+    }
+
+    ~task() {
+        if (_coro) {
+            _coro.destroy();
+        }
+    }
+
+    /// Whether the coroutine has run to completion
+    bool done() const noexcept { return !_coro || _coro.done(); }
+
+    /**
+     * Run the coroutine until its first suspension point without awaiting it.
+     * Whoever resumes it from there will run it to completion. For use by event
+     * loops.
+     */
+    void start() {
+        neo_assert(expects, _coro && !_coro.done(), "start() was called on a finished task");
+        _coro.resume();
+    }
+
+    /// Obtain the result of a finished task, rethrowing its exception, if any
+    T result() {
+        neo_assert(expects, done() && _coro, "Cannot get the result of an unfinished task");
+        return _coro.promise().result();
+    }
+
+    awaiter operator co_await() && noexcept {
+        neo_assert(expects, !!_coro, "Awaited an empty task");
+        return awaiter{_coro};
+    }
+};
+
+namespace detail {
+
+template <typename T>
+task<T> task_promise<T>::get_return_object() noexcept {
+    return task<T>(std::coroutine_handle<task_promise>::from_promise(*this));
+}
+
+inline task<void> task_promise<void>::get_return_object() noexcept {
+    return task<void>(std::coroutine_handle<task_promise>::from_promise(*this));
+}
+
+}  // namespace detail
+
+}  // namespace neo
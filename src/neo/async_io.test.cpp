@@ -0,0 +1,87 @@
+#include <neo/async_io.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/string_io.hpp>
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+NEO_TEST_CONCEPT(neo::awaitable<neo::task<int>>);
+NEO_TEST_CONCEPT(neo::awaitable<neo::ready_awaitable<int>>);
+NEO_TEST_CONCEPT(neo::async_buffer_source<neo::ready_buffer_source<neo::string_dynbuf_io&>>);
+NEO_TEST_CONCEPT(neo::async_buffer_sink<neo::ready_buffer_sink<neo::string_dynbuf_io&>>);
+NEO_TEST_CONCEPT(neo::async_buffer_input<neo::const_buffer>);
+NEO_TEST_CONCEPT(neo::async_buffer_output<neo::string_dynbuf_io&>);
+static_assert(!neo::async_buffer_source<neo::string_dynbuf_io>);
+static_assert(!neo::async_buffer_sink<neo::string_dynbuf_io>);
+static_assert(std::is_same_v<neo::await_result_t<neo::task<int>>, int>);
+
+namespace {
+
+neo::task<int> add(int a, int b) { co_return a + b; }
+
+neo::task<int> add_three(int a, int b, int c) {
+    auto ab = co_await add(a, b);
+    co_return co_await add(ab, c);
+}
+
+neo::task<void> fail() {
+    throw std::runtime_error("oops");
+    co_return;
+}
+
+neo::task<std::string> catch_failure() {
+    try {
+        co_await fail();
+    } catch (const std::runtime_error& e) {
+        co_return e.what();
+    }
+    co_return "no error";
+}
+
+}  // namespace
+
+TEST_CASE("Run tasks") {
+    auto t = add_three(1, 2, 3);
+    CHECK_FALSE(t.done());
+    t.start();
+    CHECK(t.done());
+    CHECK(t.result() == 6);
+
+    auto f = fail();
+    f.start();
+    CHECK_THROWS_AS(f.result(), std::runtime_error);
+
+    auto c = catch_failure();
+    c.start();
+    CHECK(c.result() == "oops");
+}
+
+TEST_CASE("Await a synchronous source and sink") {
+    neo::string_dynbuf_io io;
+    neo::ready_buffer_sink sink{io};
+
+    auto write = [&]() -> neo::task<void> {
+        auto buf = co_await sink.prepare(5);
+        neo::buffer_copy(buf, neo::as_buffer("Hello", 5));
+        sink.commit(5);
+    };
+    auto t = write();
+    t.start();
+    CHECK(t.done());
+    CHECK(io.read_area_view() == "Hello");
+
+    auto source = neo::ensure_async_buffer_source(neo::as_buffer(std::string_view("Goodbye")));
+    auto read   = [&]() -> neo::task<std::string> {
+        auto buf = co_await source.next(4);
+        source.consume(buf.size());
+        co_return std::string(std::string_view(buf));
+    };
+    auto r = read();
+    r.start();
+    CHECK(r.result() == "Good");
+}
@@ -0,0 +1,471 @@
+#pragma once
+
+#include <neo/buffer_algorithm/transform.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/mutable_buffer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define NEO_BASE64_HAS_AVX2 1
+#endif
+
+namespace neo {
+
+/**
+ * Select the alphabet used for base64 encoding/decoding. `standard` is the
+ * alphabet of RFC 4648 section 4 (using '+' and '/'), and `url` is the
+ * URL- and filename-safe alphabet of section 5 (using '-' and '_').
+ */
+enum class base64_alphabet {
+    standard,
+    url,
+};
+
+/**
+ * Select whether a base64_encoder writes trailing '=' padding.
+ */
+enum class base64_padding {
+    pad,
+    omit,
+};
+
+namespace detail {
+
+constexpr char base64_chars_standard[]
+    = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr char base64_chars_url[]
+    = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+constexpr const char* base64_chars(base64_alphabet a) noexcept {
+    return a == base64_alphabet::url ? base64_chars_url : base64_chars_standard;
+}
+
+/// Value in a base64 decoding table for characters outside the alphabet
+constexpr std::uint8_t base64_invalid = 0xff;
+
+constexpr auto make_base64_decode_table(const char* chars) noexcept {
+    std::array<std::uint8_t, 256> tab{};
+    for (auto& v : tab) {
+        v = base64_invalid;
+    }
+    for (std::uint8_t i = 0; i < 64; ++i) {
+        tab[static_cast<unsigned char>(chars[i])] = i;
+    }
+    return tab;
+}
+
+inline constexpr auto base64_decode_table_standard
+    = make_base64_decode_table(base64_chars_standard);
+inline constexpr auto base64_decode_table_url = make_base64_decode_table(base64_chars_url);
+
+constexpr auto& base64_decode_table(base64_alphabet a) noexcept {
+    return a == base64_alphabet::url ? base64_decode_table_url : base64_decode_table_standard;
+}
+
+inline void base64_encode_group(std::byte* out, const std::byte* in, const char* chars) noexcept {
+    const auto a = std::to_integer<unsigned>(in[0]);
+    const auto b = std::to_integer<unsigned>(in[1]);
+    const auto c = std::to_integer<unsigned>(in[2]);
+    out[0]       = std::byte(chars[a >> 2]);
+    out[1]       = std::byte(chars[((a & 0x3) << 4) | (b >> 4)]);
+    out[2]       = std::byte(chars[((b & 0xf) << 2) | (c >> 6)]);
+    out[3]       = std::byte(chars[c & 0x3f]);
+}
+
+/**
+ * Encode `n_groups` groups of three bytes from `in` into groups of four
+ * characters in `out`.
+ */
+inline void base64_encode_groups(std::byte*       out,
+                                 const std::byte* in,
+                                 std::size_t      n_groups,
+                                 const char*      chars) noexcept {
+#if NEO_BASE64_HAS_AVX2
+    // Each iteration encodes eight groups (24 bytes), but reads 28 bytes, so
+    // keep two groups in reserve.
+    if (n_groups >= 10) {
+        // Splits each three-byte group into the four bytes [b1, b0, b2, b1]
+        const auto shuf = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,  //
+                                           1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+        // Offsets to add to each sextet to produce the character, selected by
+        // the range in which the sextet falls.
+        const auto c62    = static_cast<char>(chars[62] - 62);
+        const auto c63    = static_cast<char>(chars[63] - 63);
+        const auto offset = _mm256_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, c62,
+                                             c63, 0, 0, 65, 71, -4, -4, -4, -4, -4, -4, -4, -4,
+                                             -4, -4, c62, c63, 0, 0);
+        for (; n_groups >= 10; n_groups -= 8, in += 24, out += 32) {
+            const auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+            const auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 12));
+            auto       v  = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+            v             = _mm256_shuffle_epi8(v, shuf);
+            // Move each sextet into its own byte
+            const auto t0 = _mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00));
+            const auto t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+            const auto t2 = _mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0));
+            const auto t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+            v             = _mm256_or_si256(t1, t3);
+            // Map [0, 26) -> 0, [26, 52) -> 1, [52, 62) -> 2..11, 62 -> 12, 63 -> 13
+            auto idx = _mm256_subs_epu8(v, _mm256_set1_epi8(51));
+            idx = _mm256_sub_epi8(idx, _mm256_cmpgt_epi8(v, _mm256_set1_epi8(25)));
+            v   = _mm256_add_epi8(v, _mm256_shuffle_epi8(offset, idx));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), v);
+        }
+    }
+#endif
+    for (; n_groups; --n_groups, in += 3, out += 4) {
+        base64_encode_group(out, in, chars);
+    }
+}
+
+/**
+ * Decode groups of four base64 characters from `in` into groups of three bytes
+ * in `out`. Stops at the first group that contains a character outside of the
+ * alphabet (including padding), and returns the number of groups that were
+ * decoded.
+ */
+inline std::size_t base64_decode_groups(std::byte*                           out,
+                                        const std::byte*                     in,
+                                        std::size_t                          n_groups,
+                                        const char*                          chars,
+                                        const std::array<std::uint8_t, 256>& table) noexcept {
+    const auto n_groups_total = n_groups;
+#if NEO_BASE64_HAS_AVX2
+    if (n_groups >= 8) {
+        const auto c62 = _mm256_set1_epi8(chars[62]);
+        const auto c63 = _mm256_set1_epi8(chars[63]);
+        const auto d62 = _mm256_set1_epi8(static_cast<char>(62 - chars[62]));
+        const auto d63 = _mm256_set1_epi8(static_cast<char>(63 - chars[63]));
+        // Packs each four sextets into three bytes, and the bytes into the low 24
+        const auto pack_shuf = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1,
+                                                -1, -1, 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12,
+                                                -1, -1, -1, -1);
+        const auto pack_perm = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, -1, -1);
+        auto in_range = [](__m256i v, char lo, char hi) {
+            return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(char(lo - 1))),
+                                    _mm256_cmpgt_epi8(_mm256_set1_epi8(char(hi + 1)), v));
+        };
+        for (; n_groups >= 8; n_groups -= 8, in += 32, out += 24) {
+            const auto v     = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+            const auto upper = in_range(v, 'A', 'Z');
+            const auto lower = in_range(v, 'a', 'z');
+            const auto digit = in_range(v, '0', '9');
+            const auto is_62 = _mm256_cmpeq_epi8(v, c62);
+            const auto is_63 = _mm256_cmpeq_epi8(v, c63);
+            const auto valid = _mm256_or_si256(_mm256_or_si256(upper, lower),
+                                               _mm256_or_si256(digit,
+                                                               _mm256_or_si256(is_62, is_63)));
+            if (_mm256_movemask_epi8(valid) != -1) {
+                // Let the scalar loop find the bad group
+                break;
+            }
+            auto delta = _mm256_and_si256(upper, _mm256_set1_epi8(-65));
+            delta      = _mm256_or_si256(delta, _mm256_and_si256(lower, _mm256_set1_epi8(-71)));
+            delta      = _mm256_or_si256(delta, _mm256_and_si256(digit, _mm256_set1_epi8(4)));
+            delta      = _mm256_or_si256(delta, _mm256_and_si256(is_62, d62));
+            delta      = _mm256_or_si256(delta, _mm256_and_si256(is_63, d63));
+            auto sextets = _mm256_add_epi8(v, delta);
+            auto merged  = _mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x01400140));
+            merged       = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+            merged       = _mm256_shuffle_epi8(merged, pack_shuf);
+            merged       = _mm256_permutevar8x32_epi32(merged, pack_perm);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_castsi256_si128(merged));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 16),
+                             _mm256_extracti128_si256(merged, 1));
+        }
+    }
+#else
+    (void)chars;
+#endif
+    for (; n_groups; --n_groups, in += 4, out += 3) {
+        const unsigned v0 = table[std::to_integer<unsigned char>(in[0])];
+        const unsigned v1 = table[std::to_integer<unsigned char>(in[1])];
+        const unsigned v2 = table[std::to_integer<unsigned char>(in[2])];
+        const unsigned v3 = table[std::to_integer<unsigned char>(in[3])];
+        if ((v0 | v1 | v2 | v3) == base64_invalid) {
+            // Every valid value is less than 64, so only an invalid value can
+            // produce this
+            break;
+        }
+        out[0] = std::byte((v0 << 2) | (v1 >> 4));
+        out[1] = std::byte(((v1 & 0xf) << 4) | (v2 >> 2));
+        out[2] = std::byte(((v2 & 0x3) << 6) | v3);
+    }
+    return n_groups_total - n_groups;
+}
+
+}  // namespace detail
+
+/**
+ * A buffer_transformer that encodes data as base64.
+ *
+ * Input that does not fill a complete group of three bytes is held until more
+ * input arrives, and output that does not fit in the output buffer is held
+ * until more room is given, so the data may be split at any byte boundary. Call
+ * with an empty input and `transform_finish` to write the final partial group
+ * and padding.
+ */
+class base64_encoder {
+    const char*              _chars    = detail::base64_chars_standard;
+    bool                     _pad      = true;
+    bool                     _finished = false;
+    std::array<std::byte, 3> _in_group{};
+    std::size_t              _in_have = 0;
+    std::array<std::byte, 4> _out_group{};
+    std::size_t              _out_pos = 0;
+    std::size_t              _out_end = 0;
+
+    std::size_t _drain(mutable_buffer& out) noexcept {
+        const auto n = (std::min)(_out_end - _out_pos, out.size());
+        std::copy_n(_out_group.data() + _out_pos, n, out.data());
+        _out_pos += n;
+        out += n;
+        return n;
+    }
+
+    simple_transform_result _encode(mutable_buffer out, const_buffer in) noexcept {
+        simple_transform_result res;
+        while (true) {
+            res.bytes_written += _drain(out);
+            if (_out_pos != _out_end) {
+                break;
+            }
+
+            if (_in_have == 0 && in.size() >= 3 && out.size() >= 4) {
+                // Fast path: Encode every whole group that fits in both buffers
+                const auto n_groups = (std::min)(in.size() / 3, out.size() / 4);
+                detail::base64_encode_groups(out.data(), in.data(), n_groups, _chars);
+                in += n_groups * 3;
+                out += n_groups * 4;
+                res.bytes_read += n_groups * 3;
+                res.bytes_written += n_groups * 4;
+                continue;
+            }
+
+            // Collect a group that straddles the end of one of the buffers
+            const auto n_take = (std::min)(3 - _in_have, in.size());
+            std::copy_n(in.data(), n_take, _in_group.data() + _in_have);
+            _in_have += n_take;
+            in += n_take;
+            res.bytes_read += n_take;
+            if (_in_have != 3) {
+                break;
+            }
+            detail::base64_encode_group(_out_group.data(), _in_group.data(), _chars);
+            _in_have = 0;
+            _out_pos = 0;
+            _out_end = 4;
+        }
+        return res;
+    }
+
+public:
+    constexpr base64_encoder() = default;
+    constexpr explicit base64_encoder(base64_alphabet alpha,
+                                      base64_padding  pad = base64_padding::pad) noexcept
+        : _chars(detail::base64_chars(alpha))
+        , _pad(pad == base64_padding::pad) {}
+
+    simple_transform_result operator()(mutable_buffer out, const_buffer in) noexcept {
+        return _encode(out, in);
+    }
+
+    simple_transform_result
+    operator()(mutable_buffer out, const_buffer in, transform_finish_t) noexcept {
+        if (!in.empty()) {
+            return _encode(out, in);
+        }
+        if (!_finished) {
+            _finished = true;
+            if (_in_have != 0) {
+                // Encode the final partial group, with zeros for the missing bytes
+                std::fill(_in_group.begin() + _in_have, _in_group.end(), std::byte(0));
+                detail::base64_encode_group(_out_group.data(), _in_group.data(), _chars);
+                const auto n_chars = _in_have + 1;
+                std::fill(_out_group.begin() + n_chars, _out_group.end(), std::byte('='));
+                _out_pos = 0;
+                _out_end = _pad ? 4 : n_chars;
+                _in_have = 0;
+            }
+        }
+        simple_transform_result res;
+        res.bytes_written = _drain(out);
+        res.done          = _out_pos == _out_end;
+        return res;
+    }
+};
+
+/**
+ * A buffer_transformer that decodes base64 data.
+ *
+ * Trailing '=' padding is accepted but not required. The transformer declares
+ * `done` after it reads the padding, or when it is called with an empty input
+ * and `transform_finish`. If the input contains a character that is not part
+ * of the alphabet, the transformer stops before that character, sets
+ * `has_error()`, and declares `done`.
+ */
+class base64_decoder {
+    enum class state_t : unsigned char {
+        running,
+        padding,
+        done,
+        error,
+    };
+
+    const char*                          _chars = detail::base64_chars_standard;
+    const std::array<std::uint8_t, 256>* _table = &detail::base64_decode_table_standard;
+    state_t                              _state = state_t::running;
+    std::array<std::uint8_t, 4>          _in_group{};
+    std::size_t                          _in_have    = 0;
+    std::size_t                          _n_pad      = 0;
+    std::size_t                          _pad_needed = 0;
+    std::array<std::byte, 3>             _out_group{};
+    std::size_t                          _out_pos    = 0;
+    std::size_t                          _out_end    = 0;
+
+    std::size_t _drain(mutable_buffer& out) noexcept {
+        const auto n = (std::min)(_out_end - _out_pos, out.size());
+        std::copy_n(_out_group.data() + _out_pos, n, out.data());
+        _out_pos += n;
+        out += n;
+        return n;
+    }
+
+    /// Decode the `n_chars` collected characters into the pending output
+    void _flush_group(std::size_t n_chars) noexcept {
+        auto& g = _in_group;
+        std::fill(g.begin() + n_chars, g.end(), std::uint8_t(0));
+        _out_group[0] = std::byte((g[0] << 2) | (g[1] >> 4));
+        _out_group[1] = std::byte(((g[1] & 0xf) << 4) | (g[2] >> 2));
+        _out_group[2] = std::byte(((g[2] & 0x3) << 6) | g[3]);
+        _out_pos      = 0;
+        _out_end      = n_chars - 1;
+        _in_have      = 0;
+    }
+
+    /// End the input. Returns `false` if the input ended partway through a byte.
+    bool _end_input() noexcept {
+        if (_in_have == 1) {
+            return false;
+        }
+        if (_in_have != 0) {
+            _flush_group(_in_have);
+        }
+        return true;
+    }
+
+    void _take_char(std::byte b) noexcept {
+        const auto c = std::to_integer<unsigned char>(b);
+        if (_state == state_t::padding) {
+            if (c != '=') {
+                _state = state_t::error;
+                return;
+            }
+            ++_n_pad;
+        } else if (c == '=') {
+            if (_in_have < 2) {
+                _state = state_t::error;
+                return;
+            }
+            // Each pad character stands in for one missing character of the group
+            _n_pad      = 1;
+            _pad_needed = 4 - _in_have;
+            _state      = state_t::padding;
+            _end_input();
+        } else {
+            const auto v = (*_table)[c];
+            if (v == detail::base64_invalid) {
+                _state = state_t::error;
+                return;
+            }
+            _in_group[_in_have++] = v;
+            if (_in_have == 4) {
+                _flush_group(4);
+            }
+            return;
+        }
+        if (_n_pad == _pad_needed) {
+            _state = state_t::done;
+        }
+    }
+
+    simple_transform_result _decode(mutable_buffer out, const_buffer in) noexcept {
+        simple_transform_result res;
+        while (true) {
+            res.bytes_written += _drain(out);
+            if (_out_pos != _out_end) {
+                break;
+            }
+            if (_state == state_t::done || _state == state_t::error) {
+                res.done = true;
+                break;
+            }
+
+            if (_state == state_t::running && _in_have == 0 && in.size() >= 4
+                && out.size() >= 3) {
+                // Fast path: Decode every whole group that fits in both buffers
+                const auto n_groups = (std::min)(in.size() / 4, out.size() / 3);
+                const auto n_done = detail::base64_decode_groups(out.data(),
+                                                                 in.data(),
+                                                                 n_groups,
+                                                                 _chars,
+                                                                 *_table);
+                in += n_done * 4;
+                out += n_done * 3;
+                res.bytes_read += n_done * 4;
+                res.bytes_written += n_done * 3;
+                if (n_done == n_groups) {
+                    continue;
+                }
+                // The next group holds padding or an invalid character. Fall
+                // through to handle it one character at a time.
+            }
+
+            if (in.empty()) {
+                break;
+            }
+            _take_char(in[0]);
+            if (_state == state_t::error) {
+                // Do not consume the bad character
+                continue;
+            }
+            in += 1;
+            res.bytes_read += 1;
+        }
+        return res;
+    }
+
+public:
+    constexpr base64_decoder() = default;
+    constexpr explicit base64_decoder(base64_alphabet alpha) noexcept
+        : _chars(detail::base64_chars(alpha))
+        , _table(&detail::base64_decode_table(alpha)) {}
+
+    /// Whether the decoder has encountered invalid input
+    constexpr bool has_error() const noexcept { return _state == state_t::error; }
+
+    simple_transform_result operator()(mutable_buffer out, const_buffer in) noexcept {
+        return _decode(out, in);
+    }
+
+    simple_transform_result
+    operator()(mutable_buffer out, const_buffer in, transform_finish_t) noexcept {
+        if (!in.empty()) {
+            return _decode(out, in);
+        }
+        if (_state == state_t::running) {
+            _state = _end_input() ? state_t::done : state_t::error;
+        } else if (_state == state_t::padding) {
+            // Input ended in the middle of the padding
+            _state = state_t::done;
+        }
+        return _decode(out, in);
+    }
+};
+
+}  // namespace neo
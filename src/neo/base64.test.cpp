@@ -0,0 +1,247 @@
+#include <neo/base64.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/spsc_ring.hpp>
+#include <neo/string_io.hpp>
+#include <neo/test_concept.hpp>
+#include <neo/transform_io.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <string_view>
+
+using namespace std::literals;
+
+NEO_TEST_CONCEPT(neo::buffer_transformer<neo::base64_encoder>);
+NEO_TEST_CONCEPT(neo::buffer_transformer<neo::base64_encoder, neo::transform_finish_t>);
+NEO_TEST_CONCEPT(neo::buffer_transformer<neo::base64_decoder>);
+NEO_TEST_CONCEPT(neo::buffer_transformer<neo::base64_decoder, neo::transform_finish_t>);
+
+namespace {
+
+std::string make_input(std::size_t size) {
+    std::string ret;
+    for (std::size_t i = 0; i < size; ++i) {
+        ret.push_back(static_cast<char>(i * 7 + 3));
+    }
+    return ret;
+}
+
+/// A simple reference implementation to compare against
+std::string naive_encode(std::string_view in, std::string_view chars, bool pad) {
+    std::string ret;
+    std::size_t i = 0;
+    for (; i + 3 <= in.size(); i += 3) {
+        const auto a = static_cast<unsigned char>(in[i]);
+        const auto b = static_cast<unsigned char>(in[i + 1]);
+        const auto c = static_cast<unsigned char>(in[i + 2]);
+        ret.push_back(chars[a >> 2]);
+        ret.push_back(chars[((a & 3) << 4) | (b >> 4)]);
+        ret.push_back(chars[((b & 15) << 2) | (c >> 6)]);
+        ret.push_back(chars[c & 63]);
+    }
+    if (i + 1 == in.size()) {
+        const auto a = static_cast<unsigned char>(in[i]);
+        ret.push_back(chars[a >> 2]);
+        ret.push_back(chars[(a & 3) << 4]);
+        ret.append(pad ? "==" : "");
+    } else if (i + 2 == in.size()) {
+        const auto a = static_cast<unsigned char>(in[i]);
+        const auto b = static_cast<unsigned char>(in[i + 1]);
+        ret.push_back(chars[a >> 2]);
+        ret.push_back(chars[((a & 3) << 4) | (b >> 4)]);
+        ret.push_back(chars[(b & 15) << 2]);
+        ret.append(pad ? "=" : "");
+    }
+    return ret;
+}
+
+template <typename Transformer>
+std::string transform_all(std::string_view in, Transformer&& tr) {
+    neo::string_dynbuf_io out;
+    neo::buffer_transform(tr, out, neo::as_buffer(in));
+    neo::buffer_transform(tr, out, neo::const_buffer(), neo::transform_finish);
+    return std::string(out.read_area_view());
+}
+
+std::string encode(std::string_view in, neo::base64_encoder enc = {}) {
+    return transform_all(in, enc);
+}
+
+std::string decode(std::string_view in, neo::base64_decoder dec = {}) {
+    return transform_all(in, dec);
+}
+
+constexpr std::string_view std_chars
+    = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr std::string_view url_chars
+    = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+}  // namespace
+
+TEST_CASE("RFC 4648 test vectors") {
+    auto [plain, encoded] = GENERATE(table<std::string_view, std::string_view>({
+        {"", ""},
+        {"f", "Zg=="},
+        {"fo", "Zm8="},
+        {"foo", "Zm9v"},
+        {"foob", "Zm9vYg=="},
+        {"fooba", "Zm9vYmE="},
+        {"foobar", "Zm9vYmFy"},
+    }));
+    CHECK(encode(plain) == encoded);
+    CHECK(decode(encoded) == plain);
+}
+
+TEST_CASE("Encode and decode long data") {
+    const auto size  = GENERATE(30u, 31u, 32u, 100u, 1000u, 4097u);
+    const auto input = make_input(size);
+
+    auto encoded = encode(input);
+    CHECK(encoded == naive_encode(input, std_chars, true));
+    CHECK(decode(encoded) == input);
+
+    auto url_encoded = encode(input, neo::base64_encoder{neo::base64_alphabet::url});
+    CHECK(url_encoded == naive_encode(input, url_chars, true));
+    CHECK(decode(url_encoded, neo::base64_decoder{neo::base64_alphabet::url}) == input);
+
+    auto unpadded = encode(input,
+                           neo::base64_encoder{neo::base64_alphabet::url,
+                                               neo::base64_padding::omit});
+    CHECK(unpadded == naive_encode(input, url_chars, false));
+    CHECK(decode(unpadded, neo::base64_decoder{neo::base64_alphabet::url}) == input);
+}
+
+TEST_CASE("Encode through a sink in uneven pieces") {
+    const auto                 input = make_input(1000);
+    neo::string_dynbuf_io      out;
+    neo::buffer_transform_sink sink{out, neo::base64_encoder{}};
+    for (std::size_t pos = 0, len = 1; pos < input.size(); pos += len, len += 5) {
+        neo::buffer_copy(sink, neo::as_buffer(input) + pos, len);
+    }
+    auto res = sink.finish();
+    CHECK(res.done);
+    out.shrink_uncommitted();
+    CHECK(out.storage() == naive_encode(input, std_chars, true));
+}
+
+TEST_CASE("Encode and decode through sources") {
+    // The encoder holds back a partial group until the source is finished
+    neo::string_dynbuf_io        in{"hello"};
+    neo::buffer_transform_source enc_source{in, neo::base64_encoder{}};
+    neo::string_dynbuf_io        encoded;
+    neo::buffer_copy(encoded, enc_source);
+    CHECK(encoded.read_area_view() == "aGVs");
+    enc_source.finish();
+    neo::buffer_copy(encoded, enc_source);
+    CHECK(encoded.read_area_view() == "aGVsbG8=");
+
+    const auto                   input = make_input(1000);
+    neo::string_dynbuf_io        long_in{std::string(input)};
+    neo::buffer_transform_source long_enc{long_in, neo::base64_encoder{}};
+    neo::buffer_transform_source long_dec{long_enc, neo::base64_decoder{}};
+    neo::string_dynbuf_io        out;
+    long_enc.finish();
+    long_dec.finish();
+    neo::buffer_copy(out, long_dec);
+    CHECK_FALSE(long_dec.transformer().has_error());
+    CHECK(out.read_area_view() == input);
+}
+
+TEST_CASE("Encode from a ring buffer that is filled in bursts") {
+    neo::spsc_byte_ring          ring{64};
+    auto                         prod = ring.producer();
+    neo::buffer_transform_source enc{ring.consumer(), neo::base64_encoder{}};
+    neo::string_dynbuf_io        out;
+
+    // The ring runs dry between bursts, which must not end the encoding
+    for (std::string_view burst : {"a", "bc", "defg", "h"}) {
+        neo::buffer_copy(prod, neo::as_buffer(burst));
+        neo::buffer_copy(out, enc);
+    }
+    enc.finish();
+    neo::buffer_copy(out, enc);
+    CHECK(out.read_area_view() == "YWJjZGVmZ2g=");
+}
+
+TEST_CASE("Transform with tiny output buffers") {
+    const auto          input   = make_input(100);
+    const auto          encoded = naive_encode(input, std_chars, true);
+    neo::base64_encoder enc;
+    neo::const_buffer   in_buf = neo::as_buffer(input);
+
+    std::string out;
+    char        c = 0;
+    while (true) {
+        auto out_buf = neo::mutable_buffer(neo::byte_pointer(&c), 1);
+        auto res     = in_buf.empty() ? enc(out_buf, in_buf, neo::transform_finish)
+                                      : enc(out_buf, in_buf);
+        in_buf += res.bytes_read;
+        out.append(res.bytes_written, c);
+        if (res.done) {
+            break;
+        }
+        CHECK(res.bytes_written == 1);
+    }
+    CHECK(out == encoded);
+
+    neo::base64_decoder dec;
+    in_buf = neo::as_buffer(encoded);
+    std::string decoded;
+    while (true) {
+        auto res = dec(neo::mutable_buffer(neo::byte_pointer(&c), 1), in_buf);
+        in_buf += res.bytes_read;
+        decoded.append(res.bytes_written, c);
+        if (res.done) {
+            break;
+        }
+    }
+    CHECK(decoded == input);
+}
+
+TEST_CASE("Decode errors") {
+    neo::base64_decoder dec;
+    CHECK(decode("Zm9v!mFy", dec) == "foo");
+
+    neo::string_dynbuf_io out;
+    auto                  res = neo::buffer_transform(dec, out, neo::as_buffer("Zm9v!mFy"sv));
+    CHECK(res.done);
+    CHECK(res.bytes_read == 4);
+    CHECK(dec.has_error());
+
+    // An error deep within data that is decoded in bulk
+    auto encoded = naive_encode(make_input(300), std_chars, true);
+    encoded[201] = '*';
+    neo::base64_decoder dec2;
+    out = {};
+    res = neo::buffer_transform(dec2, out, neo::as_buffer(encoded));
+    CHECK(dec2.has_error());
+    CHECK(res.bytes_read == 201);
+    CHECK(out.read_area_view() == make_input(300).substr(0, 150));
+
+    // Input that ends partway through a byte
+    neo::base64_decoder dec3;
+    out = {};
+    neo::buffer_transform(dec3, out, neo::as_buffer("Zm9vY"sv));
+    CHECK_FALSE(dec3.has_error());
+    neo::buffer_transform(dec3, out, neo::const_buffer(), neo::transform_finish);
+    CHECK(dec3.has_error());
+
+    // Padding in the wrong place
+    neo::base64_decoder dec4;
+    out = {};
+    neo::buffer_transform(dec4, out, neo::as_buffer("Zm9vY=Fy"sv));
+    CHECK(dec4.has_error());
+}
+
+TEST_CASE("Decoding stops after padding") {
+    neo::base64_decoder   dec;
+    neo::string_dynbuf_io out;
+    auto res = neo::buffer_transform(dec, out, neo::as_buffer("Zm8=Zm9v"sv));
+    CHECK(res.done);
+    CHECK(res.bytes_read == 4);
+    CHECK_FALSE(dec.has_error());
+    CHECK(out.read_area_view() == "fo");
+}
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <neo/buffer_algorithm/transform.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/detail/byteswap.hpp>
+#include <neo/mutable_buffer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define NEO_BITWISE_TRANSFORM_HAS_AVX2 1
+#endif
+
+namespace neo {
+
+namespace detail {
+
+/**
+ * XOR `n` bytes of `src` with a repeating four-byte `key` and write them to
+ * `dest`. The key is always aligned with `src[0]`. `dest` and `src` may be
+ * equal, but must not otherwise overlap.
+ */
+inline void xor_repeat4(std::byte*                      dest,
+                        const std::byte*                src,
+                        std::size_t                     n,
+                        const std::array<std::byte, 4>& key) noexcept {
+#if NEO_BITWISE_TRANSFORM_HAS_AVX2
+    std::int32_t key_i32;
+    std::memcpy(&key_i32, key.data(), 4);
+    const auto key_v = _mm256_set1_epi32(key_i32);
+    for (; n >= 32; n -= 32, src += 32, dest += 32) {
+        auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest), _mm256_xor_si256(v, key_v));
+    }
+#endif
+    std::byte key8_bytes[8];
+    std::memcpy(key8_bytes, key.data(), 4);
+    std::memcpy(key8_bytes + 4, key.data(), 4);
+    std::uint64_t key8;
+    std::memcpy(&key8, key8_bytes, 8);
+    for (; n >= 8; n -= 8, src += 8, dest += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, src, 8);
+        word ^= key8;
+        std::memcpy(dest, &word, 8);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        dest[i] = src[i] ^ key[i % 4];
+    }
+}
+
+/**
+ * Like byteswap_words(), but with a vectorized loop where it is available. This
+ * is kept apart from byteswap_words() so that only this header pulls in the
+ * intrinsics.
+ */
+template <std::size_t Width>
+void byteswap_words_simd(std::byte* dest, const std::byte* src, std::size_t n) noexcept {
+#if NEO_BITWISE_TRANSFORM_HAS_AVX2
+    // Shuffle mask reversing each Width-byte group within a 128-bit lane
+    alignas(32) std::int8_t mask_bytes[32];
+    for (int i = 0; i < 32; ++i) {
+        const int lane_idx = i % 16;
+        const int group    = lane_idx / static_cast<int>(Width);
+        const int in_group = lane_idx % static_cast<int>(Width);
+        mask_bytes[i]      = static_cast<std::int8_t>(group * static_cast<int>(Width)
+                                                 + (static_cast<int>(Width) - 1 - in_group));
+    }
+    const auto mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(mask_bytes));
+    for (; n >= 32; n -= 32, src += 32, dest += 32) {
+        auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest), _mm256_shuffle_epi8(v, mask));
+    }
+#endif
+    byteswap_words<Width>(dest, src, n);
+}
+
+}  // namespace detail
+
+/**
+ * A size-preserving buffer_transformer that XORs the data with a repeating
+ * four-byte key, as used to mask WebSocket frame payloads. Because XOR is its
+ * own inverse, the same transformer both masks and unmasks.
+ *
+ * The position within the key is carried across calls, so the data may be
+ * split at any byte boundary.
+ */
+class xor_mask_transformer {
+    std::array<std::byte, 4> _key{};
+    std::size_t              _phase = 0;
+
+public:
+    constexpr xor_mask_transformer() = default;
+    constexpr explicit xor_mask_transformer(std::array<std::byte, 4> key) noexcept
+        : _key(key) {}
+
+    /// The key given at construction
+    constexpr auto& key() const noexcept { return _key; }
+    /// The offset into the key that will be applied to the next byte
+    constexpr std::size_t phase() const noexcept { return _phase; }
+
+    simple_transform_result operator()(mutable_buffer out, const_buffer in) noexcept {
+        const auto n = (std::min)(out.size(), in.size());
+        // Rotate the key so that it lines up with the first input byte
+        std::array<std::byte, 4> rot;
+        for (std::size_t i = 0; i < 4; ++i) {
+            rot[i] = _key[(_phase + i) % 4];
+        }
+        detail::xor_repeat4(out.data(), in.data(), n, rot);
+        _phase = (_phase + n) % 4;
+        return {n, n, false};
+    }
+};
+
+template <>
+inline constexpr bool buffer_transformer_is_inplace_safe_v<xor_mask_transformer> = true;
+
+/**
+ * A size-preserving buffer_transformer that inverts every bit of the data.
+ */
+struct bitnot_transformer {
+    simple_transform_result operator()(mutable_buffer out, const_buffer in) const noexcept {
+        const auto n = (std::min)(out.size(), in.size());
+        detail::xor_repeat4(out.data(),
+                            in.data(),
+                            n,
+                            {std::byte{0xff}, std::byte{0xff}, std::byte{0xff}, std::byte{0xff}});
+        return {n, n, false};
+    }
+};
+
+template <>
+inline constexpr bool buffer_transformer_is_inplace_safe_v<bitnot_transformer> = true;
+
+/**
+ * A size-preserving buffer_transformer that reverses the byte order of each
+ * consecutive `Width`-byte word of the data.
+ *
+ * Words that straddle buffer boundaries are held in a small internal buffer
+ * until they are complete, so the data may be split at any byte boundary. The
+ * total length of the data should be a multiple of `Width`: Any trailing
+ * partial word is held back, and is reported by `pending()`. When called with
+ * an empty input and `transform_finish`, the transformer declares `done` once
+ * every swapped word has been written, and sets `has_error()` if the data
+ * ended partway through a word.
+ */
+template <std::size_t Width>
+class byteswap_transformer {
+    static_assert(Width == 2 || Width == 4 || Width == 8,
+                  "byteswap_transformer supports 16, 32, and 64-bit words");
+
+    std::array<std::byte, Width> _word{};
+    std::size_t                  _have      = 0;
+    std::size_t                  _drain_pos = 0;
+    std::size_t                  _drain_end = 0;
+    bool                         _error     = false;
+
+public:
+    /// The number of input bytes that are held, awaiting the rest of their word
+    constexpr std::size_t pending() const noexcept { return _have; }
+    /// Whether the data was finished partway through a word
+    constexpr bool has_error() const noexcept { return _error; }
+
+    simple_transform_result operator()(mutable_buffer out, const_buffer in) noexcept {
+        simple_transform_result res;
+        while (true) {
+            // Drain a word that has been completed and swapped
+            const auto n_drain = (std::min)(_drain_end - _drain_pos, out.size());
+            std::copy_n(_word.data() + _drain_pos, n_drain, out.data());
+            _drain_pos += n_drain;
+            out += n_drain;
+            res.bytes_written += n_drain;
+            if (_drain_pos != _drain_end) {
+                break;
+            }
+
+            if (_have == 0 && in.size() >= Width && out.size() >= Width) {
+                // Fast path: Swap every whole word that fits in both buffers
+                const auto n = (std::min)(in.size(), out.size()) / Width * Width;
+                detail::byteswap_words_simd<Width>(out.data(), in.data(), n);
+                in += n;
+                out += n;
+                res.bytes_read += n;
+                res.bytes_written += n;
+                continue;
+            }
+
+            // Collect a word that straddles the end of one of the buffers
+            const auto n_take = (std::min)(Width - _have, in.size());
+            std::copy_n(in.data(), n_take, _word.data() + _have);
+            _have += n_take;
+            in += n_take;
+            res.bytes_read += n_take;
+            if (_have != Width) {
+                break;
+            }
+            std::reverse(_word.begin(), _word.end());
+            _have      = 0;
+            _drain_pos = 0;
+            _drain_end = Width;
+        }
+        return res;
+    }
+
+    simple_transform_result
+    operator()(mutable_buffer out, const_buffer in, transform_finish_t) noexcept {
+        auto res = (*this)(out, in);
+        if (!in.empty() || _drain_pos != _drain_end) {
+            return res;
+        }
+        if (_have != 0) {
+            _error = true;
+        }
+        res.done = true;
+        return res;
+    }
+};
+
+using byteswap16_transformer = byteswap_transformer<2>;
+using byteswap32_transformer = byteswap_transformer<4>;
+using byteswap64_transformer = byteswap_transformer<8>;
+
+}  // namespace neo
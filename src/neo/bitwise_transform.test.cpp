@@ -0,0 +1,163 @@
+#include <neo/bitwise_transform.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/string_io.hpp>
+#include <neo/test_concept.hpp>
+#include <neo/transform_io.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+
+NEO_TEST_CONCEPT(neo::buffer_transformer<neo::xor_mask_transformer>);
+NEO_TEST_CONCEPT(neo::buffer_transformer<neo::bitnot_transformer>);
+NEO_TEST_CONCEPT(neo::buffer_transformer<neo::byteswap16_transformer>);
+NEO_TEST_CONCEPT(neo::buffer_transformer<neo::byteswap32_transformer>);
+NEO_TEST_CONCEPT(neo::buffer_transformer<neo::byteswap64_transformer>);
+
+namespace {
+
+std::string make_input(std::size_t size) {
+    std::string ret;
+    for (std::size_t i = 0; i < size; ++i) {
+        ret.push_back(static_cast<char>(i * 7 + 3));
+    }
+    return ret;
+}
+
+}  // namespace
+
+TEST_CASE("XOR mask") {
+    const std::array<std::byte, 4> key
+        = {std::byte{0x37}, std::byte{0xfa}, std::byte{0x21}, std::byte{0x3d}};
+    // Example frame from RFC 6455, section 5.7
+    const std::string masked = "\x7f\x9f\x4d\x51\x58";
+
+    neo::string_dynbuf_io out;
+    neo::buffer_transform(neo::xor_mask_transformer{key}, out, neo::as_buffer(masked));
+    CHECK(out.read_area_view() == "Hello");
+
+    // Masking a long input in pieces is equivalent to masking it in one pass
+    const auto  input = make_input(1000);
+    std::string whole = input;
+    neo::xor_mask_transformer{key}(neo::as_buffer(whole), neo::as_buffer(whole));
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        CHECK(static_cast<std::byte>(whole[i]) == (static_cast<std::byte>(input[i]) ^ key[i % 4]));
+    }
+
+    neo::xor_mask_transformer split{key};
+    std::string               pieces = input;
+    for (std::size_t pos = 0, len = 1; pos < pieces.size(); pos += len, len += 3) {
+        auto part = neo::as_buffer(pieces) + pos;
+        part      = neo::mutable_buffer(part.data(), (std::min)(len, part.size()));
+        auto res  = split(part, part);
+        CHECK(res.bytes_read == part.size());
+    }
+    CHECK(pieces == whole);
+}
+
+TEST_CASE("Bitwise NOT") {
+    const auto  input = make_input(77);
+    std::string out;
+    out.resize(input.size());
+    auto res = neo::bitnot_transformer{}(neo::as_buffer(out), neo::as_buffer(input));
+    CHECK(res.bytes_written == 77);
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        CHECK(out[i] == static_cast<char>(~input[i]));
+    }
+}
+
+TEST_CASE("Byteswap") {
+    const auto input = make_input(64 * 3);
+
+    auto check_swapped = [&](const std::string& out, std::size_t width) {
+        REQUIRE(out.size() == input.size());
+        for (std::size_t i = 0; i < input.size(); ++i) {
+            const auto word = i / width * width;
+            CHECK(out[i] == input[word + (width - 1 - (i - word))]);
+        }
+    };
+
+    neo::string_dynbuf_io out16;
+    neo::buffer_transform(neo::byteswap16_transformer{}, out16, neo::as_buffer(input));
+    check_swapped(std::string(out16.read_area_view()), 2);
+
+    neo::string_dynbuf_io out32;
+    neo::buffer_transform(neo::byteswap32_transformer{}, out32, neo::as_buffer(input));
+    check_swapped(std::string(out32.read_area_view()), 4);
+
+    neo::string_dynbuf_io out64;
+    neo::buffer_transform(neo::byteswap64_transformer{}, out64, neo::as_buffer(input));
+    check_swapped(std::string(out64.read_area_view()), 8);
+}
+
+TEST_CASE("Byteswap words that straddle buffers") {
+    const auto                  input = make_input(40);
+    neo::byteswap64_transformer tr;
+
+    std::string out;
+    out.resize(input.size());
+    auto out_buf = neo::as_buffer(out);
+    auto in_buf  = neo::as_buffer(input);
+
+    // Input ends partway through a word
+    auto res = tr(out_buf, neo::const_buffer(in_buf.data(), 5));
+    CHECK(res.bytes_read == 5);
+    CHECK(res.bytes_written == 0);
+    CHECK(tr.pending() == 5);
+    in_buf += res.bytes_read;
+
+    // Output ends partway through a word
+    res = tr(neo::mutable_buffer(out_buf.data(), 3), in_buf);
+    CHECK(res.bytes_written == 3);
+    CHECK(tr.pending() == 0);
+    in_buf += res.bytes_read;
+    out_buf += res.bytes_written;
+
+    // Finish the rest in one go
+    res = tr(out_buf, in_buf);
+    CHECK(res.bytes_read == in_buf.size());
+    CHECK(res.bytes_written == out_buf.size());
+    CHECK(tr.pending() == 0);
+
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        const auto word = i / 8 * 8;
+        CHECK(out[i] == input[word + (7 - (i - word))]);
+    }
+}
+
+TEST_CASE("Byteswap through a transforming sink") {
+    const auto                 input = make_input(100);
+    neo::string_dynbuf_io      out;
+    neo::buffer_transform_sink sink{out, neo::byteswap32_transformer{}};
+    // Write in pieces that do not line up with the words
+    for (std::size_t pos = 0; pos < input.size(); pos += 7) {
+        neo::buffer_copy(sink, neo::as_buffer(input) + pos, 7);
+    }
+    out.shrink_uncommitted();
+    const auto str = out.storage();
+    REQUIRE(str.size() == 100);
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        const auto word = i / 4 * 4;
+        CHECK(str[i] == input[word + (3 - (i - word))]);
+    }
+}
+
+TEST_CASE("Finish a byteswap") {
+    const auto                 input = make_input(10);
+    neo::string_dynbuf_io      out;
+    neo::buffer_transform_sink sink{out, neo::byteswap32_transformer{}};
+    neo::buffer_copy(sink, neo::as_buffer(input, 8));
+    auto res = sink.finish();
+    CHECK(res.done);
+    CHECK_FALSE(sink.transformer().has_error());
+    CHECK(out.available() == 8);
+
+    // A trailing partial word is an error rather than being dropped silently
+    neo::buffer_copy(sink, neo::as_buffer(input) + 8);
+    res = sink.finish();
+    CHECK(res.done);
+    CHECK(sink.transformer().has_error());
+    CHECK(sink.transformer().pending() == 2);
+    CHECK(out.available() == 8);
+}
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "./buffer_algorithm/compare.hpp"
 #include "./buffer_algorithm/copy.hpp"
 #include "./buffer_algorithm/count.hpp"
+#include "./buffer_algorithm/fill.hpp"
 #include "./buffer_algorithm/size.hpp"
 #include "./buffer_algorithm/transform.hpp"
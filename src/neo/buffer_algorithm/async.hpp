@@ -0,0 +1,188 @@
+#pragma once
+
+#include <neo/async_io.hpp>
+
+#include "./copy.hpp"
+#include "./decode.hpp"
+#include "./encode.hpp"
+#include "./size.hpp"
+#include "./transform.hpp"
+
+#include <limits>
+
+/**
+ * Coroutine versions of the buffer algorithms. Each one returns a neo::task
+ * that `co_await`s the `next()` and `prepare()` of its async_buffer_source and
+ * async_buffer_sink arguments, so that a single thread may drive many streams
+ * at once. Synchronous buffer ranges, sources, and sinks are accepted as well,
+ * and never cause a suspension.
+ *
+ * The tasks are lazy. Arguments that are given as rvalues are moved into the
+ * task, while lvalues are held by reference and must outlive it.
+ */
+namespace neo {
+
+namespace detail {
+
+// The coroutines take each argument as its deduced type, so that rvalues are
+// moved into the coroutine frame while lvalues remain references.
+
+template <typename Dest, typename Source>
+task<std::size_t> async_buffer_copy(Dest dest_, Source src_, std::size_t max_copy) {
+    auto remaining = max_copy;
+
+    auto&& out = ensure_async_buffer_sink(static_cast<Dest&&>(dest_));
+    auto&& in  = ensure_async_buffer_source(static_cast<Source&&>(src_));
+
+    while (remaining != 0) {
+        auto in_part  = co_await in.next(remaining);
+        auto out_part = co_await out.prepare(buffer_size(in_part));
+        auto n_copied = buffer_copy(out_part, in_part, remaining);
+        if (n_copied == 0) {
+            break;
+        }
+        in.consume(n_copied);
+        out.commit(n_copied);
+        remaining -= n_copied;
+    }
+
+    co_return max_copy - remaining;
+}
+
+template <typename Result, typename Tr, typename Out, typename In, typename... Args>
+task<Result> async_buffer_transform(Tr tr, Out out_, In in_, Args... args) {
+    using policy_type = buffer_transform_chunk_policy_t<std::remove_cvref_t<Tr>>;
+    static_assert(buffer_transform_chunk_policy<policy_type>);
+    policy_type policy;
+
+    auto&& in  = ensure_async_buffer_source(static_cast<In&&>(in_));
+    auto&& out = ensure_async_buffer_sink(static_cast<Out&&>(out_));
+
+    Result result_acc;
+
+    while (true) {
+        auto       in_part        = co_await in.next(policy.input_size());
+        const auto in_size        = buffer_size(in_part);
+        auto       out_part       = co_await out.prepare(policy.output_size(in_size));
+        auto       partial_result = buffer_transform(tr, out_part, in_part, args...);
+        in.consume(partial_result.bytes_read);
+        out.commit(partial_result.bytes_written);
+        policy.update(in_size,
+                      buffer_size(out_part),
+                      partial_result.bytes_read,
+                      partial_result.bytes_written);
+        result_acc += partial_result;
+        if (result_acc.done) {
+            break;
+        }
+        if (partial_result.bytes_read == 0 && partial_result.bytes_written == 0) {
+            break;
+        }
+    }
+
+    co_return result_acc;
+}
+
+template <typename Result, typename Enc, typename Out, typename T>
+task<Result> async_buffer_encode(Enc enc, Out out_, T val) {
+    Result      result{};
+    std::size_t total_written = 0;
+
+    auto&& out = ensure_async_buffer_sink(static_cast<Out&&>(out_));
+
+    while (!result.done()) {
+        auto next = co_await out.prepare(1024);
+        if (buffer_is_empty(next)) {
+            break;
+        }
+        auto partial = buffer_encode(enc, next, val);
+        total_written += partial.bytes_written;
+        out.commit(partial.bytes_written);
+        result = partial;
+    }
+
+    result.bytes_written = total_written;
+    co_return result;
+}
+
+template <typename Result, typename Dec, typename Source>
+task<Result> async_buffer_decode(Dec decode, Source source) {
+    Result      result;
+    std::size_t total_read = 0;
+
+    auto&& in = ensure_async_buffer_source(static_cast<Source&&>(source));
+
+    while (true) {
+        auto next = co_await in.next(1024);
+        if (buffer_is_empty(next)) {
+            break;
+        }
+        auto partial = buffer_decode(decode, next);
+        total_read += partial.bytes_read;
+        in.consume(partial.bytes_read);
+
+        result = std::move(partial);
+        if (result.has_value() || result.has_error()) {
+            break;
+        }
+    }
+
+    result.bytes_read = total_read;
+    co_return result;
+}
+
+}  // namespace detail
+
+/**
+ * Copy data from `src` into `dest`, up to `max_copy` bytes. The task gives the
+ * number of bytes that were copied.
+ */
+template <async_buffer_output Dest, async_buffer_input Source>
+task<std::size_t>
+async_buffer_copy(Dest&&      dest,
+                  Source&&    src,
+                  std::size_t max_copy = std::numeric_limits<std::size_t>::max()) {
+    return detail::async_buffer_copy<Dest, Source>(NEO_FWD(dest), NEO_FWD(src), max_copy);
+}
+
+/**
+ * Transform the data from `in` into `out` until the transformer is done or
+ * makes no more progress. This is the coroutine equivalent of the
+ * sink/source overload of buffer_transform(), and uses the same chunk policy.
+ */
+template <async_buffer_output Out,
+          async_buffer_input  In,
+          typename... Args,
+          buffer_transformer<Args...> Tr>
+task<buffer_transform_result_t<Tr, Args...>>
+async_buffer_transform(Tr&& tr, Out&& out, In&& in, Args&&... args) {
+    return detail::async_buffer_transform<buffer_transform_result_t<Tr, Args...>,
+                                          Tr,
+                                          Out,
+                                          In,
+                                          Args...>(NEO_FWD(tr),
+                                                   NEO_FWD(out),
+                                                   NEO_FWD(in),
+                                                   NEO_FWD(args)...);
+}
+
+/**
+ * Encode a single item into `out`.
+ */
+template <async_buffer_output Out, typename T, buffer_encoder<T> Enc>
+task<buffer_encode_result_t<Enc, T>> async_buffer_encode(Enc&& enc, Out&& out, T&& val) {
+    return detail::async_buffer_encode<buffer_encode_result_t<Enc, T>, Enc, Out, T>(NEO_FWD(enc),
+                                                                                     NEO_FWD(out),
+                                                                                     NEO_FWD(val));
+}
+
+/**
+ * Decode a single item from `source`.
+ */
+template <buffer_decoder Dec, async_buffer_input Source>
+task<buffer_decode_result_t<Dec>> async_buffer_decode(Dec&& decode, Source&& source) {
+    return detail::async_buffer_decode<buffer_decode_result_t<Dec>, Dec, Source>(NEO_FWD(decode),
+                                                                                 NEO_FWD(source));
+}
+
+}  // namespace neo
@@ -0,0 +1,184 @@
+#include "./async.hpp"
+
+#include <neo/as_buffer.hpp>
+#include <neo/bitwise_transform.hpp>
+#include <neo/string_io.hpp>
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <coroutine>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace {
+
+/// A queue of suspended coroutines, resumed in order
+struct run_queue {
+    std::deque<std::coroutine_handle<>> ready;
+
+    template <typename T>
+    T run(neo::task<T> t) {
+        t.start();
+        while (!ready.empty()) {
+            auto h = ready.front();
+            ready.pop_front();
+            h.resume();
+        }
+        return t.result();
+    }
+};
+
+struct suspend_to {
+    run_queue& q;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) const { q.ready.push_back(h); }
+    void await_resume() const noexcept {}
+};
+
+/// A source that suspends on every call to next(), and gives at most three bytes
+struct trickle_source {
+    run_queue&       q;
+    std::string_view data;
+
+    struct next_op : suspend_to {
+        trickle_source& self;
+        std::size_t     n;
+
+        neo::const_buffer await_resume() const noexcept {
+            return neo::as_buffer(self.data.substr(0, (std::min)(n, std::size_t(3))));
+        }
+    };
+
+    next_op next(std::size_t n) noexcept { return next_op{{q}, *this, n}; }
+    void    consume(std::size_t n) noexcept { data.remove_prefix(n); }
+};
+
+/// A sink that suspends on every call to prepare(), and gives at most five bytes
+struct trickle_sink {
+    run_queue&               q;
+    std::string              out;
+    std::array<std::byte, 5> scratch;
+
+    struct prepare_op : suspend_to {
+        trickle_sink& self;
+        std::size_t   n;
+
+        neo::mutable_buffer await_resume() const noexcept {
+            return neo::mutable_buffer(self.scratch.data(), (std::min)(n, self.scratch.size()));
+        }
+    };
+
+    prepare_op prepare(std::size_t n) noexcept { return prepare_op{{q}, *this, n}; }
+    void       commit(std::size_t n) {
+        out.append(reinterpret_cast<const char*>(scratch.data()), n);
+    }
+};
+
+struct be_u32_encoder {
+    std::size_t off = 0;
+
+    struct result {
+        std::size_t bytes_written = 0;
+        bool        done_         = false;
+        bool        done() const noexcept { return done_; }
+    };
+
+    result operator()(neo::mutable_buffer mb, std::uint32_t i) {
+        std::array<std::byte, 4> bytes = {std::byte(i >> 24),
+                                          std::byte(i >> 16),
+                                          std::byte(i >> 8),
+                                          std::byte(i)};
+        auto part = neo::as_buffer(bytes) + off;
+        auto n    = neo::buffer_copy(mb, part);
+        off += n;
+        return {n, off == 4};
+    }
+};
+
+struct line_decoder {
+    struct result {
+        std::optional<std::string> line;
+        std::size_t                bytes_read = 0;
+
+        std::string& value() noexcept { return *line; }
+        bool         has_value() const noexcept { return line.has_value(); }
+        bool         has_error() const noexcept { return false; }
+    };
+
+    std::string partial;
+
+    result operator()(neo::const_buffer cb) {
+        auto sv = std::string_view(cb);
+        auto nl = sv.find('\n');
+        if (nl == sv.npos) {
+            partial.append(sv);
+            return {std::nullopt, sv.size()};
+        }
+        partial.append(sv.substr(0, nl));
+        return {std::move(partial), nl + 1};
+    }
+};
+
+}  // namespace
+
+NEO_TEST_CONCEPT(neo::async_buffer_source<trickle_source>);
+NEO_TEST_CONCEPT(neo::async_buffer_sink<trickle_sink>);
+
+TEST_CASE("Copy between async sources and sinks") {
+    run_queue      q;
+    trickle_source in{q, "Hello, async world!"};
+    trickle_sink   out{q, {}, {}};
+
+    auto n = q.run(neo::async_buffer_copy(out, in));
+    CHECK(n == 19);
+    CHECK(out.out == "Hello, async world!");
+
+    // Synchronous inputs and outputs never suspend
+    neo::string_dynbuf_io io;
+    auto t = neo::async_buffer_copy(io, neo::as_buffer("sync", 4));
+    t.start();
+    CHECK(t.done());
+    CHECK(io.read_area_view() == "sync");
+}
+
+TEST_CASE("Transform from an async source") {
+    run_queue             q;
+    std::string           text = "Some text to be inverted";
+    trickle_source        in{q, text};
+    neo::string_dynbuf_io out;
+
+    auto res = q.run(neo::async_buffer_transform(neo::bitnot_transformer{}, out, in));
+    CHECK(res.bytes_read == text.size());
+    CHECK(out.available() == text.size());
+    for (auto& c : text) {
+        c = static_cast<char>(~c);
+    }
+    CHECK(out.read_area_view() == text);
+}
+
+TEST_CASE("Encode into an async sink") {
+    run_queue    q;
+    trickle_sink out{q, {}, {}};
+
+    std::uint32_t value = 0x41424344;
+    auto          res   = q.run(neo::async_buffer_encode(be_u32_encoder{}, out, value));
+    CHECK(res.done());
+    CHECK(res.bytes_written == 4);
+    CHECK(out.out == "ABCD");
+}
+
+TEST_CASE("Decode from an async source") {
+    run_queue      q;
+    trickle_source in{q, "first line\nsecond"};
+
+    auto res = q.run(neo::async_buffer_decode(line_decoder{}, in));
+    REQUIRE(res.has_value());
+    CHECK(res.value() == "first line");
+    CHECK(res.bytes_read == 11);
+    CHECK(in.data == "second");
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <neo/buffer_range.hpp>
+
+#include "./size.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace neo {
+
+/**
+ * Low-level buffer comparison. Compares `s` bytes of `a` and `b` lexicographically, returning a
+ * negative value, zero, or a positive value (in the same manner as `std::memcmp`).
+ */
+constexpr int ll_buffer_compare(const std::byte* a, const std::byte* b, std::size_t s) noexcept {
+#ifdef __cpp_lib_is_constant_evaluated
+    if (!std::is_constant_evaluated()) {
+        return std::memcmp(a, b, s);
+    }
+#endif
+    for (; s; --s, ++a, ++b) {
+        if (*a != *b) {
+            return *a < *b ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+namespace detail {
+
+struct buffer_compare_prefix_result {
+    /// The result of comparing the common prefix of the two ranges
+    int order = 0;
+    /// Whether the left-hand range was exhausted before a difference was found
+    bool left_exhausted = false;
+    /// Whether the right-hand range was exhausted before a difference was found
+    bool right_exhausted = false;
+};
+
+template <typename T>
+concept cheap_buffer_size = single_buffer<T> || has_member_buffer_size<T>;
+
+/**
+ * Compare two buffer ranges until a difference is found or either range is exhausted. Each step
+ * compares the largest contiguous run that is available in both ranges.
+ */
+template <buffer_range Left, buffer_range Right>
+constexpr buffer_compare_prefix_result buffer_compare_prefix(const Left&  left,
+                                                             const Right& right) noexcept {
+    auto       left_it    = std::begin(left);
+    const auto left_stop  = std::end(left);
+    auto       right_it   = std::begin(right);
+    const auto right_stop = std::end(right);
+
+    const_buffer left_part;
+    const_buffer right_part;
+
+    while (true) {
+        // Skip to the next non-empty buffer on each side
+        while (left_part.empty() && left_it != left_stop) {
+            left_part = *left_it;
+            ++left_it;
+        }
+        while (right_part.empty() && right_it != right_stop) {
+            right_part = *right_it;
+            ++right_it;
+        }
+        if (left_part.empty() || right_part.empty()) {
+            return {0, left_part.empty(), right_part.empty()};
+        }
+        const auto n = (std::min)(left_part.size(), right_part.size());
+        if (auto order = ll_buffer_compare(left_part.data(), right_part.data(), n); order != 0) {
+            return {order, false, false};
+        }
+        left_part += n;
+        right_part += n;
+    }
+}
+
+}  // namespace detail
+
+/**
+ * Lexicographically compare the bytes of two buffer ranges. Returns a negative value if `left`
+ * orders before `right`, zero if they are equal, and a positive value otherwise. The two ranges
+ * may be segmented differently.
+ */
+template <buffer_range Left, buffer_range Right>
+constexpr int buffer_compare(const Left& left, const Right& right) noexcept {
+    auto res = detail::buffer_compare_prefix(left, right);
+    if (res.order != 0) {
+        return res.order;
+    }
+    if (res.left_exhausted && res.right_exhausted) {
+        return 0;
+    }
+    return res.left_exhausted ? -1 : 1;
+}
+
+/**
+ * Determine whether two buffer ranges contain identical bytes. The two ranges may be segmented
+ * differently.
+ */
+template <buffer_range Left, buffer_range Right>
+constexpr bool buffer_equal(const Left& left, const Right& right) noexcept {
+    if constexpr (detail::cheap_buffer_size<Left> && detail::cheap_buffer_size<Right>) {
+        // We can check the sizes up-front without walking the ranges
+        if (buffer_size(left) != buffer_size(right)) {
+            return false;
+        }
+    }
+    auto res = detail::buffer_compare_prefix(left, right);
+    return res.order == 0 && res.left_exhausted && res.right_exhausted;
+}
+
+/**
+ * Determine whether the bytes of `bufs` begin with the bytes of `prefix`.
+ */
+template <buffer_range Bufs, buffer_range Prefix>
+constexpr bool buffer_starts_with(const Bufs& bufs, const Prefix& prefix) noexcept {
+    if constexpr (detail::cheap_buffer_size<Bufs> && detail::cheap_buffer_size<Prefix>) {
+        if (buffer_size(bufs) < buffer_size(prefix)) {
+            return false;
+        }
+    }
+    auto res = detail::buffer_compare_prefix(bufs, prefix);
+    return res.order == 0 && res.right_exhausted;
+}
+
+}  // namespace neo
@@ -0,0 +1,50 @@
+#include "./compare.hpp"
+
+#include <neo/as_buffer.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace neo::literals;
+
+TEST_CASE("Compare single buffers") {
+    CHECK(neo::buffer_equal("foo"_buf, "foo"_buf));
+    CHECK_FALSE(neo::buffer_equal("foo"_buf, "food"_buf));
+    CHECK_FALSE(neo::buffer_equal("foo"_buf, "bar"_buf));
+
+    CHECK(neo::buffer_compare("foo"_buf, "foo"_buf) == 0);
+    CHECK(neo::buffer_compare("foo"_buf, "food"_buf) < 0);
+    CHECK(neo::buffer_compare("food"_buf, "foo"_buf) > 0);
+    CHECK(neo::buffer_compare("bar"_buf, "foo"_buf) < 0);
+    CHECK(neo::buffer_compare(""_buf, ""_buf) == 0);
+    CHECK(neo::buffer_compare(""_buf, "a"_buf) < 0);
+    // Bytes compare as unsigned
+    CHECK(neo::buffer_compare("\x7f"_buf, "\x80"_buf) < 0);
+
+    CHECK(neo::buffer_starts_with("foobar"_buf, "foo"_buf));
+    CHECK(neo::buffer_starts_with("foobar"_buf, ""_buf));
+    CHECK_FALSE(neo::buffer_starts_with("foo"_buf, "foobar"_buf));
+    CHECK_FALSE(neo::buffer_starts_with("foobar"_buf, "bar"_buf));
+}
+
+TEST_CASE("Compare differently-segmented buffer ranges") {
+    auto left  = {"Hello, "_buf, ""_buf, "world!"_buf};
+    auto right = {"He"_buf, "llo, wor"_buf, "ld"_buf, "!"_buf};
+    CHECK(neo::buffer_equal(left, right));
+    CHECK(neo::buffer_equal(left, "Hello, world!"_buf));
+    CHECK(neo::buffer_compare(left, right) == 0);
+    CHECK(neo::buffer_starts_with(left, "Hello, w"_buf));
+    CHECK(neo::buffer_starts_with("Hello, world! Hi!"_buf, right));
+
+    auto other = {"Hello, "_buf, "World!"_buf};
+    CHECK_FALSE(neo::buffer_equal(left, other));
+    CHECK(neo::buffer_compare(left, other) > 0);
+    CHECK(neo::buffer_compare(other, right) < 0);
+
+    std::vector<neo::const_buffer> empty;
+    CHECK(neo::buffer_equal(empty, ""_buf));
+    CHECK(neo::buffer_compare(empty, left) < 0);
+    CHECK(neo::buffer_starts_with(left, empty));
+}
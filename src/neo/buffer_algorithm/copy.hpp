@@ -198,6 +198,9 @@ public:
         auto n_copied = buffer_copy(dest, src, _ll_copy);
         return {n_copied, n_copied, false};
     }
+
+    /// Copying passes all data through unchanged
+    constexpr std::size_t passthrough(const_buffer src) const noexcept { return src.size(); }
 };
 
 }  // namespace neo
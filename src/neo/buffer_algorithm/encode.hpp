@@ -2,10 +2,17 @@
 
 #include <neo/buffer_range.hpp>
 #include <neo/buffer_sink.hpp>
+#include <neo/byte_pointer.hpp>
+#include <neo/detail/byteswap.hpp>
 
 #include <neo/iterator_concepts.hpp>
 #include <neo/out.hpp>
 
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
 #ifdef __has_include
 #if __has_include(<version>)
 #include <version>
@@ -37,6 +44,64 @@ template <typename Enc, typename T>
 using buffer_encode_result_t = std::invoke_result_t<Enc, mutable_buffer, T&>;
 // clang-format on
 
+/**
+ * Specialize for a buffer_encoder whose encoding of each `value_type` is
+ * exactly the object representation of the value, either as-is or with its
+ * byte order reversed. A specialization provides:
+ *
+ * - `using value_type = ...`: The trivially-copyable type that is encoded.
+ * - `static constexpr bool byteswap`: Whether the bytes of each value are
+ *   reversed.
+ *
+ * The range overload of buffer_encode() uses this to encode contiguous arrays
+ * of such values with a bulk copy or byteswap into large output windows,
+ * rather than one element at a time.
+ */
+template <typename Enc>
+struct buffer_encoder_bulk_traits {};
+
+// clang-format off
+template <typename Enc, typename T>
+concept buffer_bulk_encoder =
+    requires {
+        typename buffer_encoder_bulk_traits<Enc>::value_type;
+        { buffer_encoder_bulk_traits<Enc>::byteswap } -> alike<bool>;
+    } &&
+    same_as<typename buffer_encoder_bulk_traits<Enc>::value_type, T> &&
+    std::is_trivially_copyable_v<T> &&
+    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+// clang-format on
+
+/// The largest window that the bulk encoding path will prepare at once
+inline constexpr std::size_t buffer_encode_bulk_window_size = 1024 * 1024;
+
+namespace detail {
+
+/**
+ * Encode `count` values of type `T` starting at `src` into the front of `window`,
+ * writing only whole values. Returns the number of values that were written.
+ */
+template <typename T, bool ByteSwap, mutable_buffer_range Window>
+std::size_t bulk_encode_into(Window&& window, const T* src, std::size_t count) noexcept {
+    std::size_t n_done = 0;
+    for (mutable_buffer part : window) {
+        const auto n = (std::min)(part.size() / sizeof(T), count - n_done);
+        if constexpr (ByteSwap && sizeof(T) > 1) {
+            byteswap_words<sizeof(T)>(part.data(), byte_pointer(src + n_done), n * sizeof(T));
+        } else {
+            std::memcpy(part.data(), src + n_done, n * sizeof(T));
+        }
+        n_done += n;
+        if (n * sizeof(T) != part.size()) {
+            // Either we are done, or a value straddles the end of this part
+            break;
+        }
+    }
+    return n_done;
+}
+
+}  // namespace detail
+
 /**
  * Base overload: Encode a single item into a buffer/range/sink
  */
@@ -85,6 +150,43 @@ constexpr decltype(auto) buffer_encode(Enc&&                      enc,
 
     auto&& out = ensure_buffer_sink(out_);
 
+    using value_type = std::iter_value_t<Iter>;
+    if constexpr (std::contiguous_iterator<Iter> && std::sized_sentinel_for<Sentinel, Iter>
+                  && buffer_bulk_encoder<std::remove_cvref_t<Enc>, value_type>) {
+        if (!std::is_constant_evaluated()) {
+            using traits            = buffer_encoder_bulk_traits<std::remove_cvref_t<Enc>>;
+            constexpr bool byteswap = traits::byteswap;
+            // Encode all but the final value in bulk. The final value goes through the encoder
+            // below, so that it gives us a proper result.
+            while (stop - it > 1) {
+                const auto n_bulk = static_cast<std::size_t>(stop - it - 1);
+                auto window = out.prepare((std::min)(n_bulk * sizeof(value_type),
+                                                     buffer_encode_bulk_window_size));
+                const auto n_done
+                    = detail::bulk_encode_into<value_type, byteswap>(window,
+                                                                     std::to_address(it),
+                                                                     n_bulk);
+                out.commit(n_done * sizeof(value_type));
+                total_written += n_done * sizeof(value_type);
+                it += static_cast<std::iter_difference_t<Iter>>(n_done);
+                if (n_done == 0) {
+                    // The window cannot hold a whole value. Let the encoder split one value
+                    // across the window boundary.
+                    if (buffer_is_empty(window)) {
+                        break;
+                    }
+                    auto partial = buffer_encode(enc, out, *it);
+                    total_written += partial.bytes_written;
+                    result = partial;
+                    ++it;
+                    if (!partial.done()) {
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
     for (; it != stop; ++it) {
         auto next = out.prepare(1024);
         if (buffer_is_empty(next)) {
@@ -7,6 +7,11 @@
 
 #include <catch2/catch.hpp>
 
+#include <bit>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
 namespace {
 
 struct be_int32_encoder {
@@ -33,8 +38,42 @@ struct be_int32_encoder {
     }
 };
 
+/// Encodes an int16 as its native-endian object representation
+struct native_int16_encoder {
+    std::size_t off = 0;
+
+    struct result {
+        std::size_t bytes_written = 0;
+        bool        done_         = false;
+        auto        done() const noexcept { return done_; }
+    };
+
+    result operator()(neo::mutable_buffer mb, std::int16_t i) {
+        auto cbuf      = neo::trivial_buffer(i) + off;
+        auto n_written = neo::buffer_copy(mb, cbuf);
+        off += n_written;
+        off %= 2;
+        return {.bytes_written = n_written, .done_ = n_written == cbuf.size()};
+    }
+};
+
 }  // namespace
 
+template <>
+struct neo::buffer_encoder_bulk_traits<be_int32_encoder> {
+    using value_type               = std::int32_t;
+    static constexpr bool byteswap = std::endian::native == std::endian::little;
+};
+
+template <>
+struct neo::buffer_encoder_bulk_traits<native_int16_encoder> {
+    using value_type               = std::int16_t;
+    static constexpr bool byteswap = false;
+};
+
+static_assert(neo::buffer_bulk_encoder<be_int32_encoder, std::int32_t>);
+static_assert(!neo::buffer_bulk_encoder<be_int32_encoder, std::int16_t>);
+
 TEST_CASE("Encode a single integer into one buffer") {
     std::string str = "1234";
 
@@ -69,4 +108,58 @@ TEST_CASE("Encode a range of objects") {
                          "\x00\x00\x00\x03"
                          "\x00\x00\x00\x04",
                          16));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Bulk-encode a contiguous range") {
+    std::vector<std::int32_t> values;
+    for (int i = 0; i < 100'000; ++i) {
+        values.push_back(i * 7919 - 1'000'000);
+    }
+
+    // A deque is not contiguous, so it is encoded one element at a time
+    std::deque<std::int32_t> slow_values(values.begin(), values.end());
+    std::string              expect;
+    neo::dynbuf_io           expect_io{expect};
+    neo::buffer_encode(be_int32_encoder(), expect_io, slow_values);
+    REQUIRE(expect_io.available() == values.size() * 4);
+
+    std::string    str;
+    neo::dynbuf_io str_io{str};
+    auto           res = neo::buffer_encode(be_int32_encoder(), str_io, values);
+    CHECK(res.done());
+    CHECK(res.bytes_written == values.size() * 4);
+    CHECK(str_io.available() == values.size() * 4);
+    CHECK(str.substr(0, str_io.available()) == expect.substr(0, expect_io.available()));
+
+    std::vector<std::int16_t> shorts = {1, -2, 3, -4, 5};
+    std::string               native;
+    neo::dynbuf_io            native_io{native};
+    neo::buffer_encode(native_int16_encoder(), native_io, shorts);
+    CHECK(native.substr(0, 10)
+          == std::string_view(reinterpret_cast<const char*>(shorts.data()), 10));
+}
+
+TEST_CASE("Bulk-encode across buffer boundaries") {
+    std::vector<std::int32_t> values = {0x01020304, 0x05060708, 0x090a0b0c, 0x0d0e0f10};
+    const std::string         expect("\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c"
+                             "\x0d\x0e\x0f\x10",
+                             16);
+
+    // Values straddle the boundaries between the buffers
+    std::array<char, 6>                a, b, c;
+    std::array<neo::mutable_buffer, 3> bufs = {neo::as_buffer(a),
+                                               neo::as_buffer(b),
+                                               neo::as_buffer(c)};
+    auto res = neo::buffer_encode(be_int32_encoder(), bufs, values);
+    CHECK(res.done());
+    CHECK(res.bytes_written == 16);
+    CHECK(std::string(a.data(), 6) + std::string(b.data(), 6) + std::string(c.data(), 4)
+          == expect);
+
+    // Stop mid-value when the output runs out
+    std::array<char, 10> small;
+    res = neo::buffer_encode(be_int32_encoder(), neo::as_buffer(small), values);
+    CHECK(res.bytes_written == 10);
+    CHECK_FALSE(res.done());
+    CHECK(std::string(small.data(), 10) == expect.substr(0, 10));
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <neo/buffer_range.hpp>
+#include <neo/buffer_sink.hpp>
+
+#include <neo/assert.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+namespace neo {
+
+/**
+ * Low-level buffer filler. Sets `s` bytes beginning at `dest` to `pattern`.
+ */
+constexpr void ll_buffer_fill(std::byte* dest, std::byte pattern, std::size_t s) noexcept {
+#ifdef __cpp_lib_is_constant_evaluated
+    if (!std::is_constant_evaluated()) {
+        std::memset(dest, std::to_integer<int>(pattern), s);
+        return;
+    }
+#endif
+    for (; s; --s) {
+        *dest++ = pattern;
+    }
+}
+
+/**
+ * Low-level repeated-pattern filler. Fills `s` bytes beginning at `dest` with repetitions of the
+ * `pat_size` bytes at `pat`, beginning at byte offset `phase` within the pattern.
+ *
+ * One period of the pattern is written directly, and the rest of the output is filled by copying
+ * the already-filled prefix of `dest` onto itself in doubling steps.
+ */
+constexpr void ll_buffer_fill_pattern(std::byte*       dest,
+                                      const std::byte* pat,
+                                      std::size_t      pat_size,
+                                      std::size_t      phase,
+                                      std::size_t      s) noexcept {
+    neo_assert(expects,
+               phase < pat_size,
+               "Pattern phase must be less than the pattern size",
+               phase,
+               pat_size);
+    const auto first_size = (std::min)(s, pat_size);
+    for (std::size_t i = 0; i < first_size; ++i) {
+        dest[i] = pat[(phase + i) % pat_size];
+    }
+    std::size_t filled = first_size;
+    while (filled < s) {
+        const auto n = (std::min)(filled, s - filled);
+#ifdef __cpp_lib_is_constant_evaluated
+        if (!std::is_constant_evaluated()) {
+            std::memcpy(dest + filled, dest, n);
+        } else
+#endif
+        {
+            for (std::size_t i = 0; i < n; ++i) {
+                dest[filled + i] = dest[i];
+            }
+        }
+        filled += n;
+    }
+}
+
+/**
+ * Fill up to `max_fill` bytes of the given mutable buffer range or buffer sink with the byte
+ * `pattern`. When given a sink, the filled bytes are committed. Returns the number of bytes that
+ * were filled.
+ */
+template <buffer_output Out>
+constexpr std::size_t buffer_fill(Out&& out_, std::byte pattern, std::size_t max_fill)  //
+    noexcept(noexcept_buffer_output_v<Out>) {
+    auto&& out       = ensure_buffer_sink(out_);
+    auto   remaining = max_fill;
+    while (remaining != 0) {
+        auto        part     = out.prepare(remaining);
+        std::size_t n_filled = 0;
+        for (mutable_buffer mb : part) {
+            const auto n = (std::min)(mb.size(), remaining - n_filled);
+            ll_buffer_fill(mb.data(), pattern, n);
+            n_filled += n;
+        }
+        if (n_filled == 0) {
+            break;
+        }
+        out.commit(n_filled);
+        remaining -= n_filled;
+    }
+    return max_fill - remaining;
+}
+
+/**
+ * Fill every byte of the given mutable buffer range with the byte `pattern`.
+ */
+template <mutable_buffer_range Out>
+constexpr std::size_t buffer_fill(Out&& out, std::byte pattern) noexcept {
+    return buffer_fill(out, pattern, std::numeric_limits<std::size_t>::max());
+}
+
+/**
+ * Fill up to `max_fill` bytes of the given mutable buffer range or buffer sink with repetitions
+ * of the bytes in `pattern`. The pattern continues across buffer boundaries. Returns the number
+ * of bytes that were filled.
+ */
+template <buffer_output Out>
+constexpr std::size_t buffer_fill(Out&& out_, const_buffer pattern, std::size_t max_fill)  //
+    noexcept(noexcept_buffer_output_v<Out>) {
+    neo_assert(expects, !pattern.empty(), "buffer_fill() requires a non-empty pattern");
+    if (pattern.size() == 1) {
+        return buffer_fill(out_, pattern[0], max_fill);
+    }
+    auto&&      out       = ensure_buffer_sink(out_);
+    auto        remaining = max_fill;
+    std::size_t phase     = 0;
+    while (remaining != 0) {
+        auto        part     = out.prepare(remaining);
+        std::size_t n_filled = 0;
+        for (mutable_buffer mb : part) {
+            const auto n = (std::min)(mb.size(), remaining - n_filled);
+            ll_buffer_fill_pattern(mb.data(), pattern.data(), pattern.size(), phase, n);
+            phase = (phase + n) % pattern.size();
+            n_filled += n;
+        }
+        if (n_filled == 0) {
+            break;
+        }
+        out.commit(n_filled);
+        remaining -= n_filled;
+    }
+    return max_fill - remaining;
+}
+
+/**
+ * Fill every byte of the given mutable buffer range with repetitions of `pattern`.
+ */
+template <mutable_buffer_range Out>
+constexpr std::size_t buffer_fill(Out&& out, const_buffer pattern) noexcept {
+    return buffer_fill(out, pattern, std::numeric_limits<std::size_t>::max());
+}
+
+}  // namespace neo
@@ -0,0 +1,68 @@
+#include "./fill.hpp"
+
+#include <neo/as_buffer.hpp>
+#include <neo/dynbuf_io.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+
+using namespace neo::literals;
+
+TEST_CASE("Fill a single buffer") {
+    std::string str = "Hello, world!";
+    auto        n   = neo::buffer_fill(neo::as_buffer(str), std::byte{'z'});
+    CHECK(n == 13);
+    CHECK(str == "zzzzzzzzzzzzz");
+
+    n = neo::buffer_fill(neo::as_buffer(str), std::byte{'a'}, 4);
+    CHECK(n == 4);
+    CHECK(str == "aaaazzzzzzzzz");
+}
+
+TEST_CASE("Fill a buffer range") {
+    std::string a = "12345", b = "", c = "6789";
+    auto        bufs = {neo::as_buffer(a), neo::as_buffer(b), neo::as_buffer(c)};
+    auto        n    = neo::buffer_fill(bufs, std::byte{'-'}, 7);
+    CHECK(n == 5);
+    CHECK(a == "-----");
+    CHECK(c == "6789");
+
+    auto bufs2 = {neo::as_buffer(a), neo::as_buffer(c)};
+    n          = neo::buffer_fill(bufs2, std::byte{'+'}, 7);
+    CHECK(n == 7);
+    CHECK(a == "+++++");
+    CHECK(c == "++89");
+}
+
+TEST_CASE("Fill a sink") {
+    std::string    str;
+    neo::dynbuf_io io{str};
+    auto           n = neo::buffer_fill(io, std::byte{0}, 3000);
+    CHECK(n == 3000);
+    CHECK(io.available() == 3000);
+    CHECK(str == std::string(3000, '\0'));
+}
+
+TEST_CASE("Fill with a repeated pattern") {
+    std::string str;
+    str.resize(11);
+    auto n = neo::buffer_fill(neo::as_buffer(str), "abc"_buf);
+    CHECK(n == 11);
+    CHECK(str == "abcabcabcab");
+
+    // The pattern continues across buffer boundaries:
+    std::string a = "....", b = ".", c = "........";
+    auto        bufs = {neo::as_buffer(a), neo::as_buffer(b), neo::as_buffer(c)};
+    n                = neo::buffer_fill(bufs, "12345"_buf);
+    CHECK(n == 13);
+    CHECK(a == "1234");
+    CHECK(b == "5");
+    CHECK(c == "12345123");
+
+    std::string    out;
+    neo::dynbuf_io io{out};
+    n = neo::buffer_fill(io, "xy"_buf, 2049);
+    CHECK(n == 2049);
+    CHECK(out.substr(2040, 9) == "xyxyxyxyx");
+}
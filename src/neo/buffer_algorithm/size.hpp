@@ -6,16 +6,33 @@
 
 namespace neo {
 
+namespace detail {
+
+/**
+ * Match buffer ranges that know their own size in bytes without needing to iterate their buffers.
+ */
+template <typename T>
+concept has_member_buffer_size = requires(const T& seq) {
+    { seq.buffer_size() } noexcept -> convertible_to<std::size_t>;
+};
+
+}  // namespace detail
+
 /**
  * Obtain the length of a buffer sequence, in bytes.
  */
 template <buffer_range Seq>
 constexpr std::size_t buffer_size(const Seq& seq) noexcept {
-    std::size_t size = 0;
-    for (const_buffer b : seq) {
-        size += b.size();
+    if constexpr (detail::has_member_buffer_size<Seq>) {
+        // The range knows its own size
+        return seq.buffer_size();
+    } else {
+        std::size_t size = 0;
+        for (const_buffer b : seq) {
+            size += b.size();
+        }
+        return size;
     }
-    return size;
 }
 
 constexpr std::size_t buffer_size(const_buffer b) noexcept { return b.size(); }
@@ -23,24 +40,32 @@ constexpr std::size_t buffer_size(mutable_buffer b) noexcept { return b.size();
 
 template <buffer_range R>
 constexpr bool buffer_size_at_least(R&& r, std::size_t min) noexcept {
-    std::size_t size = 0;
-    for (const_buffer b : r) {
-        size += b.size();
-        if (size >= min) {
-            return true;
+    if constexpr (detail::has_member_buffer_size<std::remove_cvref_t<R>>) {
+        return r.buffer_size() >= min;
+    } else {
+        std::size_t size = 0;
+        for (const_buffer b : r) {
+            size += b.size();
+            if (size >= min) {
+                return true;
+            }
         }
+        return false;
     }
-    return false;
 }
 
 template <buffer_range R>
 constexpr bool buffer_is_empty(R&& r) noexcept {
-    for (const_buffer b : r) {
-        if (b) {
-            return false;
+    if constexpr (detail::has_member_buffer_size<std::remove_cvref_t<R>>) {
+        return r.buffer_size() == 0;
+    } else {
+        for (const_buffer b : r) {
+            if (b) {
+                return false;
+            }
         }
+        return true;
     }
-    return true;
 }
 
 }  // namespace neo
@@ -7,6 +7,8 @@
 #include <neo/assert.hpp>
 #include <neo/invoke.hpp>
 
+#include <algorithm>
+
 namespace neo {
 
 // clang-format off
@@ -29,6 +31,132 @@ concept buffer_transformer =
 template <typename T>
 constexpr std::size_t buffer_transform_dynamic_growth_hint_v = 1024;
 
+// clang-format off
+/**
+ * A policy that decides how large of an input and output window the
+ * buffer_transform() driver should request for each call to a transformer.
+ * `input_size()` gives the size of input to request, `output_size(n)` gives the
+ * size of output to prepare for `n` bytes of input, and `update()` is told the
+ * sizes of the windows and how much of each was used.
+ */
+template <typename T>
+concept buffer_transform_chunk_policy =
+    requires(T policy, std::size_t size) {
+        { policy.input_size() } -> alike<std::size_t>;
+        { policy.output_size(size) } -> alike<std::size_t>;
+        policy.update(size, size, size, size);
+    };
+// clang-format on
+
+/**
+ * Always request windows of the same size. This was the behavior of
+ * buffer_transform() before windows were adaptive.
+ */
+template <std::size_t Size>
+struct fixed_transform_chunk_policy {
+    constexpr std::size_t input_size() const noexcept { return Size; }
+    constexpr std::size_t output_size(std::size_t) const noexcept { return Size; }
+    constexpr void update(std::size_t, std::size_t, std::size_t, std::size_t) noexcept {}
+};
+
+/**
+ * Start with windows of `Initial` bytes, and grow them as the transformer
+ * keeps up with them: the input window up to `Max` bytes, and the output window
+ * up to `MaxOut` bytes. The output window is sized from the ratio of output to
+ * input that the transformer has produced so far, so that neither side of the
+ * transform is starved. The default `MaxOut` leaves room for a full input
+ * window of a transformer that expands its data up to about four times (such as
+ * hex or base64 encoding).
+ *
+ * The policy learns from the windows that `next()` and `prepare()` actually
+ * hand back: The input window only grows when the source filled the whole
+ * request, so a source that offers small segments keeps the window small. A
+ * blocking source (such as an istream) fills whatever is requested, so `Max`
+ * is kept modest to bound the size of a single blocking read.
+ */
+template <std::size_t Initial, std::size_t Max = 64 * 1024, std::size_t MaxOut = Max * 4>
+class adaptive_transform_chunk_policy {
+    static_assert(Initial > 0 && Initial <= Max && Initial <= MaxOut);
+
+    std::size_t _in_size   = Initial;
+    std::size_t _out_min   = Initial;
+    std::size_t _total_in  = 0;
+    std::size_t _total_out = 0;
+
+public:
+    constexpr std::size_t input_size() const noexcept { return _in_size; }
+
+    constexpr std::size_t output_size(std::size_t in_size) const noexcept {
+        if (in_size == 0 || _total_in == 0) {
+            // Either draining the transformer, or we have nothing to go on yet
+            return (std::max)(_out_min, in_size);
+        }
+        const double ratio    = static_cast<double>(_total_out) / static_cast<double>(_total_in);
+        const double estimate = static_cast<double>(in_size) * ratio;
+        // Leave some slack for transformers that emit in bursts
+        const auto want = estimate >= static_cast<double>(MaxOut)
+            ? MaxOut
+            : static_cast<std::size_t>(estimate) + in_size / 8 + 16;
+        return (std::min)((std::max)(want, _out_min), MaxOut);
+    }
+
+    constexpr void update(std::size_t in_size,
+                          std::size_t out_size,
+                          std::size_t n_read,
+                          std::size_t n_written) noexcept {
+        _total_in += n_read;
+        _total_out += n_written;
+        if (n_read == in_size && in_size == _in_size) {
+            // The transformer took everything we asked for: ask for more
+            _in_size = (std::min)(_in_size * 2, Max);
+        }
+        if (n_written == out_size && n_read < in_size) {
+            // The output filled up first: make more room next time
+            _out_min = (std::min)((std::max)(out_size, Initial) * 2, MaxOut);
+        }
+    }
+};
+
+/**
+ * The chunk policy used by buffer_transform() for transformers of type `T`.
+ * Specialize this to change the policy for a transformer.
+ */
+template <typename T>
+struct buffer_transform_chunk_policy_for {
+    using type = adaptive_transform_chunk_policy<buffer_transform_dynamic_growth_hint_v<T>>;
+};
+
+template <typename T>
+using buffer_transform_chunk_policy_t = typename buffer_transform_chunk_policy_for<T>::type;
+
+/**
+ * Specialize as `true` for a buffer_transformer that may be given the same
+ * memory as both its input and its output. Such a transformer must write
+ * exactly as many bytes as it reads on every call, writing each output byte
+ * over the input byte that it was computed from. This permits
+ * buffer_transform_inplace() and buffer_transform_inplace_source, and lets
+ * buffer_transform_sink skip its intermediate buffer.
+ */
+template <typename T>
+constexpr bool buffer_transformer_is_inplace_safe_v = false;
+
+// clang-format off
+/**
+ * A buffer_transformer that can let data pass through unchanged. When given an
+ * input, `passthrough(in)` returns the number of bytes at the front of `in`
+ * that the transformer's output would be identical to, and counts them as
+ * transformed. It should return zero while the transformer holds any output
+ * that it has not yet written. buffer_transform_source uses this to hand out
+ * views of its upstream source instead of copying.
+ */
+template <typename T>
+concept buffer_passthrough_transformer =
+    buffer_transformer<T> &&
+    requires(T tr, const_buffer in) {
+        { tr.passthrough(in) } -> alike<std::size_t>;
+    };
+// clang-format on
+
 template <typename T, typename... Args>
 using buffer_transform_result_t = neo::invoke_result_t<T&, mutable_buffer, const_buffer, Args...>;
 
@@ -60,6 +188,19 @@ struct proto_buffer_transformer {
     proto_buffer_transform_result operator()(mutable_buffer mb, const_buffer cb);
 };
 
+/**
+ * Tag to pass as an additional argument to a buffer_transformer that holds back
+ * partial data between calls (e.g. an encoder that works on fixed-size
+ * groups). When called with an empty input and `transform_finish`, such a
+ * transformer writes out any data that it is holding, and declares `done` once
+ * all of it has been written.
+ *
+ * buffer_transform() passes additional arguments along to every call, so a
+ * transformer must only finish when it is given an empty input.
+ */
+struct transform_finish_t {};
+inline constexpr transform_finish_t transform_finish = {};
+
 /**
  * The base case of buffer_transform, transforms individual single buffers. It
  * is guaranteed that either the entire input or the entire output is consumed,
@@ -123,10 +264,10 @@ constexpr auto buffer_transform(Tr&& tr, Out&& out_, In&& in_, Args&&... args)
              && noexcept_buffer_input_v<In> && noexcept_buffer_output_v<Out>)  //
 {
     using result_type = buffer_transform_result_t<Tr>;
-    // The growth size can vary based on the algorithm
-    constexpr std::size_t growth_size
-        = buffer_transform_dynamic_growth_hint_v<std::remove_cvref_t<Tr>>;
-    static_assert(growth_size > 0);
+    // The sizes of the windows that we request vary based on the algorithm
+    using policy_type = buffer_transform_chunk_policy_t<std::remove_cvref_t<Tr>>;
+    static_assert(buffer_transform_chunk_policy<policy_type>);
+    policy_type policy;
 
     auto&& in  = ensure_buffer_source(in_);
     auto&& out = ensure_buffer_sink(out_);
@@ -134,11 +275,16 @@ constexpr auto buffer_transform(Tr&& tr, Out&& out_, In&& in_, Args&&... args)
     result_type result_acc;
 
     while (true) {
-        auto in_part        = in.next(growth_size);
-        auto out_part       = out.prepare(growth_size);
-        auto partial_result = buffer_transform(tr, out_part, in_part, args...);
+        auto       in_part        = in.next(policy.input_size());
+        const auto in_size        = buffer_size(in_part);
+        auto       out_part       = out.prepare(policy.output_size(in_size));
+        auto       partial_result = buffer_transform(tr, out_part, in_part, args...);
         in.consume(partial_result.bytes_read);
         out.commit(partial_result.bytes_written);
+        policy.update(in_size,
+                      buffer_size(out_part),
+                      partial_result.bytes_read,
+                      partial_result.bytes_written);
         result_acc += partial_result;
         if (result_acc.done) {
             break;
@@ -160,4 +306,34 @@ constexpr auto buffer_transform(Tr&& tr, Out&& out_, In&& in_, Args&&... args)
     return result_acc;
 }
 
+/**
+ * Transform the data in the given range of mutable buffers where it is, using
+ * a transformer that is in-place safe. Stops early if the transformer declares
+ * that it is done.
+ */
+template <typename... Args, buffer_transformer<Args...> Tr, mutable_buffer_range Bufs>
+requires buffer_transformer_is_inplace_safe_v<std::remove_cvref_t<Tr>>  //
+    constexpr auto buffer_transform_inplace(Tr&& tr, Bufs&& bufs, Args&&... args)  //
+    noexcept(noexcept(tr(mutable_buffer(), const_buffer(), args...)))             //
+{
+    using result_type = buffer_transform_result_t<Tr, Args...>;
+    result_type result_acc;
+    for (mutable_buffer buf : bufs) {
+        auto partial_result = tr(buf, const_buffer(buf), args...);
+        result_acc += partial_result;
+        if (result_acc.done) {
+            break;
+        }
+        neo_assert(invariant,
+                   partial_result.bytes_read == buf.size()
+                       && partial_result.bytes_written == buf.size(),
+                   "A transformer that is marked as in-place safe did not transform an entire "
+                   "buffer in-place",
+                   buf.size(),
+                   partial_result.bytes_read,
+                   partial_result.bytes_written);
+    }
+    return result_acc;
+}
+
 }  // namespace neo
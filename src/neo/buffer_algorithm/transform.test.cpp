@@ -78,3 +78,107 @@ TEST_CASE("Copy multi-part input") {
     CHECK(out.available() == neo::buffer_size(bufs));
     CHECK(out.read_area_view() == pasta);
 }
+
+namespace {
+
+/// Copies data, and counts the calls and the largest windows it was given
+struct counting_copy_transformer {
+    int         n_calls  = 0;
+    std::size_t max_in   = 0;
+    std::size_t max_out  = 0;
+    std::size_t expand_n = 1;
+    std::size_t phase    = 0;
+
+    neo::simple_transform_result operator()(neo::mutable_buffer out, neo::const_buffer in) {
+        ++n_calls;
+        max_in  = (std::max)(max_in, in.size());
+        max_out = (std::max)(max_out, out.size());
+        // Write each input byte `expand_n` times
+        std::size_t n_written = 0;
+        std::size_t n_read    = 0;
+        while (n_written < out.size() && n_read < in.size()) {
+            out[n_written++] = in[n_read];
+            if (++phase == expand_n) {
+                phase = 0;
+                ++n_read;
+            }
+        }
+        return {n_written, n_read, false};
+    }
+};
+
+struct fixed_window_transformer : counting_copy_transformer {};
+
+/// A source that hands out at most four KiB at a time, and records the largest request
+struct small_segment_source {
+    std::string_view data;
+    std::size_t      max_request = 0;
+
+    neo::const_buffer next(std::size_t n) {
+        max_request = (std::max)(max_request, n);
+        return neo::as_buffer(data, (std::min)(n, std::size_t(4096)));
+    }
+    void consume(std::size_t n) noexcept { data.remove_prefix(n); }
+};
+
+}  // namespace
+
+template <>
+struct neo::buffer_transform_chunk_policy_for<fixed_window_transformer> {
+    using type = neo::fixed_transform_chunk_policy<7>;
+};
+
+NEO_TEST_CONCEPT(neo::buffer_transform_chunk_policy<neo::fixed_transform_chunk_policy<7>>);
+NEO_TEST_CONCEPT(neo::buffer_transform_chunk_policy<neo::adaptive_transform_chunk_policy<1024>>);
+
+TEST_CASE("Transform windows grow with the data") {
+    std::string input(1024 * 1024, 'x');
+
+    counting_copy_transformer tr;
+    neo::string_dynbuf_io     out;
+    auto                      res = neo::buffer_transform(tr, out, neo::const_buffer(input));
+    CHECK(res.bytes_read == input.size());
+    CHECK(out.read_area_view() == input);
+    // Doubling from 1 KiB to the 64 KiB cap takes seven calls, then fifteen
+    // more to finish the data.
+    CHECK(tr.n_calls < 25);
+    CHECK(tr.max_in == 64 * 1024);
+}
+
+TEST_CASE("Transform windows stay near the size of the source's segments") {
+    std::string          input(1024 * 256, 'z');
+    small_segment_source in{input};
+
+    counting_copy_transformer tr;
+    neo::string_dynbuf_io     out;
+    auto                      res = neo::buffer_transform(tr, out, in);
+    CHECK(res.bytes_read == input.size());
+    CHECK(out.read_area_view() == input);
+    CHECK(tr.max_in == 4096);
+    // The window grows once past the segment size, and then stops
+    CHECK(in.max_request == 8192);
+}
+
+TEST_CASE("Transform windows follow the output ratio") {
+    std::string input(1024 * 200, 'y');
+
+    counting_copy_transformer tr;
+    tr.expand_n = 3;
+    neo::string_dynbuf_io out;
+    auto                  res = neo::buffer_transform(tr, out, neo::const_buffer(input));
+    CHECK(res.bytes_read == input.size());
+    CHECK(res.bytes_written == input.size() * 3);
+    CHECK(out.read_area_view() == std::string(input.size() * 3, 'y'));
+    CHECK(tr.n_calls < 20);
+    CHECK(tr.max_in == 64 * 1024);
+    CHECK(tr.max_out >= tr.max_in * 3);
+}
+
+TEST_CASE("Customize the transform chunk policy") {
+    fixed_window_transformer tr;
+    neo::string_dynbuf_io    out;
+    neo::buffer_transform(tr, out, neo::const_buffer(pasta));
+    CHECK(out.read_area_view() == pasta);
+    CHECK(tr.max_in == 7);
+    CHECK(tr.max_out == 7);
+}
@@ -0,0 +1,305 @@
+#pragma once
+
+#include "./byte_pointer.hpp"
+#include "./mutable_buffer.hpp"
+
+#include <neo/assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace neo {
+
+/**
+ * A process-wide pool of recycled memory blocks in a few fixed size classes.
+ *
+ * A request is rounded up to the smallest size class that holds it, and is
+ * served from a small cache that belongs to the calling thread, falling back to
+ * a free list that is shared by all threads (with a lock for each size class),
+ * and finally to the global allocator. Returned blocks go back to the thread's cache, and the
+ * cache spills half of its blocks to the shared free list when it fills up.
+ * Once a program has warmed up, allocation and deallocation of pooled blocks do
+ * not touch the global allocator at all.
+ *
+ * Requests larger than the largest size class are not pooled, and go directly
+ * to the global allocator. Pooled blocks are kept for the life of the program.
+ *
+ * Obtain the pool with `buffer_pool::shared()`. Blocks may be returned from any
+ * thread, not only the one that allocated them.
+ */
+class buffer_pool {
+public:
+    /// The sizes of the pooled blocks
+    static constexpr std::array<std::size_t, 3> size_classes = {
+        1024 * 4,
+        1024 * 64,
+        1024 * 1024,
+    };
+    static constexpr std::size_t n_size_classes = size_classes.size();
+
+    /// Every block is aligned to at least this many bytes
+    static constexpr std::size_t block_alignment = 1024 * 4;
+
+private:
+    // The number of blocks of each size class that a thread will cache
+    static constexpr std::array<std::size_t, n_size_classes> _thread_cache_sizes = {32, 8, 2};
+    static constexpr std::size_t _max_thread_cache_size = 32;
+
+    // A free block holds the link to the next one
+    struct free_node {
+        free_node* next;
+    };
+
+    // Each list has its own lock. The thread caches absorb most of the
+    // traffic, so the lists are only touched when a cache is empty or full.
+    struct alignas(64) free_list {
+        std::mutex mtx;
+        free_node* head = nullptr;
+    };
+
+    std::array<free_list, n_size_classes> _free_lists;
+    std::atomic<std::size_t>              _n_fresh{0};
+
+    struct thread_cache {
+        std::array<std::array<std::byte*, _max_thread_cache_size>, n_size_classes> blocks;
+        std::array<std::size_t, n_size_classes>                                    counts{};
+
+        ~thread_cache() {
+            // The shared pool outlives every thread
+            for (std::size_t cls = 0; cls < n_size_classes; ++cls) {
+                shared()._push(cls, blocks[cls].data(), counts[cls]);
+            }
+        }
+    };
+
+    static thread_cache& _local_cache() noexcept {
+        thread_local thread_cache cache;
+        return cache;
+    }
+
+    buffer_pool() = default;
+
+    static std::byte* _new_block(std::size_t size) {
+        return static_cast<std::byte*>(::operator new(size, std::align_val_t{block_alignment}));
+    }
+
+    static void _delete_block(std::byte* ptr) noexcept {
+        ::operator delete(ptr, std::align_val_t{block_alignment});
+    }
+
+    void _push(std::size_t cls, std::byte* const* blocks, std::size_t n) noexcept {
+        auto&           list = _free_lists[cls];
+        std::lock_guard lk{list.mtx};
+        for (std::size_t i = 0; i < n; ++i) {
+            list.head = new (blocks[i]) free_node{list.head};
+        }
+    }
+
+    std::byte* _pop(std::size_t cls) noexcept {
+        auto&           list = _free_lists[cls];
+        std::lock_guard lk{list.mtx};
+        auto            node = list.head;
+        if (node == nullptr) {
+            return nullptr;
+        }
+        list.head = node->next;
+        node->~free_node();
+        return reinterpret_cast<std::byte*>(node);
+    }
+
+public:
+    buffer_pool(const buffer_pool&) = delete;
+    buffer_pool& operator=(const buffer_pool&) = delete;
+
+    /// Obtain the process-wide pool
+    static buffer_pool& shared() noexcept {
+        // Never destroyed, so that threads may return their caches at any time
+        static buffer_pool* const pool = new buffer_pool();
+        return *pool;
+    }
+
+    /**
+     * Get the index of the size class that would serve a request of `size`
+     * bytes, or `n_size_classes` if the request is too large to be pooled.
+     */
+    static constexpr std::size_t size_class_for(std::size_t size) noexcept {
+        std::size_t cls = 0;
+        while (cls < n_size_classes && size_classes[cls] < size) {
+            ++cls;
+        }
+        return cls;
+    }
+
+    /// Get the size of the block that would be given for a request of `size` bytes
+    static constexpr std::size_t block_size_for(std::size_t size) noexcept {
+        const auto cls = size_class_for(size);
+        return cls == n_size_classes ? size : size_classes[cls];
+    }
+
+    /**
+     * Obtain a block of at least `size` bytes. The returned buffer views the
+     * whole block, and must be given back to `deallocate()` unmodified.
+     */
+    mutable_buffer allocate(std::size_t size) {
+        const auto cls = size_class_for(size);
+        if (cls == n_size_classes) {
+            return mutable_buffer(_new_block(size), size);
+        }
+        auto&      cache = _local_cache();
+        std::byte* block = nullptr;
+        if (cache.counts[cls] != 0) {
+            block = cache.blocks[cls][--cache.counts[cls]];
+        } else {
+            block = _pop(cls);
+        }
+        if (block == nullptr) {
+            block = _new_block(size_classes[cls]);
+            _n_fresh.fetch_add(1, std::memory_order_relaxed);
+        }
+        return mutable_buffer(block, size_classes[cls]);
+    }
+
+    /// Give back a block that was obtained from `allocate()`
+    void deallocate(mutable_buffer block) noexcept {
+        if (block.data() == nullptr) {
+            return;
+        }
+        const auto cls = size_class_for(block.size());
+        if (cls == n_size_classes) {
+            _delete_block(block.data());
+            return;
+        }
+        neo_assert(expects,
+                   block.size() == size_classes[cls],
+                   "Gave a block back to buffer_pool that did not come from allocate()",
+                   block.size());
+        auto& cache = _local_cache();
+        auto& count = cache.counts[cls];
+        if (count == _thread_cache_sizes[cls]) {
+            // Spill half of the cache, keeping the most recently used blocks
+            const auto n_spill = (count + 1) / 2;
+            _push(cls, cache.blocks[cls].data(), n_spill);
+            std::copy(cache.blocks[cls].begin() + n_spill,
+                      cache.blocks[cls].begin() + count,
+                      cache.blocks[cls].begin());
+            count -= n_spill;
+        }
+        cache.blocks[cls][count++] = block.data();
+    }
+
+    /**
+     * The number of pooled blocks that have been obtained from the global
+     * allocator. This stops growing once a program reaches a steady state.
+     */
+    std::size_t fresh_block_count() const noexcept {
+        return _n_fresh.load(std::memory_order_relaxed);
+    }
+};
+
+/**
+ * A std-compatible allocator that draws from buffer_pool::shared(). Suitable
+ * for basic_bytes, e.g. `basic_bytes<buffer_pool_allocator<std::byte>>`.
+ */
+template <typename T>
+class buffer_pool_allocator {
+public:
+    using value_type = T;
+
+    constexpr buffer_pool_allocator() noexcept = default;
+    template <typename U>
+    constexpr buffer_pool_allocator(const buffer_pool_allocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        auto block = buffer_pool::shared().allocate(n * sizeof(T));
+        return static_cast<T*>(static_cast<void*>(block.data()));
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        if (ptr == nullptr) {
+            return;
+        }
+        auto size = buffer_pool::block_size_for(n * sizeof(T));
+        buffer_pool::shared().deallocate(mutable_buffer(byte_pointer(ptr), size));
+    }
+
+    template <typename U>
+    constexpr bool operator==(const buffer_pool_allocator<U>&) const noexcept {
+        return true;
+    }
+};
+
+/**
+ * A resizable array of bytes whose storage is a block from
+ * buffer_pool::shared(). Growing within the block is free, and growing beyond
+ * it moves the data to a block of the next size class. This is usable as the
+ * storage of a dynamic buffer, e.g. `shifting_dynamic_buffer<pooled_bytes>`.
+ */
+class pooled_bytes {
+    mutable_buffer _block;
+    std::size_t    _size = 0;
+
+    void _release() noexcept {
+        buffer_pool::shared().deallocate(_block);
+        _block = mutable_buffer();
+    }
+
+public:
+    pooled_bytes() = default;
+
+    explicit pooled_bytes(std::size_t size) { resize(size); }
+
+    pooled_bytes(pooled_bytes&& o) noexcept
+        : _block(std::exchange(o._block, mutable_buffer()))
+        , _size(std::exchange(o._size, 0)) {}
+
+    pooled_bytes& operator=(pooled_bytes&& o) noexcept {
+        if (this != &o) {
+            _release();
+            _block = std::exchange(o._block, mutable_buffer());
+            _size  = std::exchange(o._size, 0);
+        }
+        return *this;
+    }
+
+    ~pooled_bytes() { _release(); }
+
+    std::byte*       data() noexcept { return _block.data(); }
+    const std::byte* data() const noexcept { return _block.data(); }
+    std::size_t      size() const noexcept { return _size; }
+    std::size_t      capacity() const noexcept { return _block.size(); }
+
+    /**
+     * Resize the array, keeping its contents. New bytes are left
+     * uninitialized. Past the largest size class, the capacity at least
+     * doubles, so that growing a little at a time stays linear.
+     */
+    void resize(std::size_t new_size) {
+        if (new_size > capacity()) {
+            auto want = new_size;
+            if (buffer_pool::size_class_for(want) == buffer_pool::n_size_classes) {
+                want = (std::max)(want, capacity() * 2);
+            }
+            auto block = buffer_pool::shared().allocate(want);
+            if (_size != 0) {
+                std::memcpy(block.data(), data(), _size);
+            }
+            _release();
+            _block = block;
+        }
+        _size = new_size;
+    }
+
+    /// Give the storage back to the pool
+    void clear() noexcept {
+        _release();
+        _size = 0;
+    }
+};
+
+}  // namespace neo
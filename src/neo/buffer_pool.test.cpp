@@ -0,0 +1,152 @@
+#include <neo/buffer_pool.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/as_dynamic_buffer.hpp>
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/bytes.hpp>
+#include <neo/dynbuf_io.hpp>
+#include <neo/shifting_dynamic_buffer.hpp>
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+NEO_TEST_CONCEPT(neo::as_dynamic_buffer_convertible<neo::pooled_bytes&>);
+NEO_TEST_CONCEPT(neo::dynamic_buffer<neo::shifting_dynamic_buffer<neo::pooled_bytes>>);
+
+static_assert(neo::buffer_pool::block_size_for(0) == 4096);
+static_assert(neo::buffer_pool::block_size_for(4097) == 65536);
+static_assert(neo::buffer_pool::block_size_for(1024 * 1024) == 1024 * 1024);
+static_assert(neo::buffer_pool::block_size_for(1024 * 1024 + 1) == 1024 * 1024 + 1);
+
+TEST_CASE("Recycle blocks from the buffer pool") {
+    auto& pool = neo::buffer_pool::shared();
+
+    auto a = pool.allocate(100);
+    CHECK(a.size() == 4096);
+    CHECK(reinterpret_cast<std::uintptr_t>(a.data()) % neo::buffer_pool::block_alignment == 0);
+    pool.deallocate(a);
+
+    // The block we just gave back is the next to be handed out
+    auto b = pool.allocate(4000);
+    CHECK(b.data() == a.data());
+    pool.deallocate(b);
+
+    // Blocks too large to pool are allocated exactly
+    auto big = pool.allocate(1024 * 1024 * 2);
+    CHECK(big.size() == 1024 * 1024 * 2);
+    pool.deallocate(big);
+
+    // Once warmed up, no more blocks are created
+    std::vector<neo::mutable_buffer> blocks;
+    for (int round = 0; round < 3; ++round) {
+        const auto n_fresh = pool.fresh_block_count();
+        for (int i = 0; i < 100; ++i) {
+            blocks.push_back(pool.allocate(i % 2 ? 1000 : 50000));
+        }
+        for (auto blk : blocks) {
+            pool.deallocate(blk);
+        }
+        blocks.clear();
+        if (round != 0) {
+            CHECK(pool.fresh_block_count() == n_fresh);
+        }
+    }
+}
+
+TEST_CASE("Share the buffer pool between threads") {
+    auto& pool = neo::buffer_pool::shared();
+
+    // Threads give back each others' blocks, through their caches and the shared lists
+    std::atomic<int>         n_corrupt{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&pool, &n_corrupt, t] {
+            std::vector<neo::mutable_buffer> held;
+            for (int i = 0; i < 5000; ++i) {
+                auto blk = pool.allocate(static_cast<std::size_t>(1000 + (i * t) % 60000));
+                neo::buffer_copy(blk, neo::const_buffer(neo::byte_pointer(&t), sizeof t));
+                held.push_back(blk);
+                if (held.size() > 40) {
+                    for (auto h : held) {
+                        int v = -1;
+                        neo::buffer_copy(neo::mutable_buffer(neo::byte_pointer(&v), sizeof v), h);
+                        if (v != t) {
+                            ++n_corrupt;
+                        }
+                        pool.deallocate(h);
+                    }
+                    held.clear();
+                }
+            }
+            for (auto h : held) {
+                pool.deallocate(h);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    CHECK(n_corrupt == 0);
+}
+
+TEST_CASE("Grow pooled_bytes past the largest size class") {
+    neo::pooled_bytes bytes;
+    bytes.resize(1024 * 1024);
+    CHECK(bytes.capacity() == 1024 * 1024);
+    bytes.data()[1024 * 1024 - 1] = std::byte(42);
+
+    int         n_grows  = 0;
+    std::size_t last_cap = bytes.capacity();
+    for (std::size_t size = 1024 * 1024; size <= 1024 * 1024 * 16; size += 4096) {
+        bytes.resize(size);
+        if (bytes.capacity() != last_cap) {
+            ++n_grows;
+            last_cap = bytes.capacity();
+        }
+    }
+    CHECK(bytes.size() == 1024 * 1024 * 16);
+    CHECK(bytes.capacity() == 1024 * 1024 * 16);
+    // The capacity doubles, rather than growing by each request
+    CHECK(n_grows == 4);
+    CHECK(bytes.data()[1024 * 1024 - 1] == std::byte(42));
+}
+
+TEST_CASE("Use pooled_bytes as dynamic buffer storage") {
+    neo::pooled_bytes bytes;
+    CHECK(bytes.capacity() == 0);
+    bytes.resize(10);
+    CHECK(bytes.capacity() == 4096);
+    neo::buffer_copy(neo::as_buffer(bytes), neo::as_buffer("0123456789", 10));
+    bytes.resize(5000);
+    CHECK(bytes.capacity() == 65536);
+    CHECK(std::string_view(reinterpret_cast<const char*>(bytes.data()), 10) == "0123456789");
+
+    neo::dynbuf_io<neo::shifting_dynamic_buffer<neo::pooled_bytes>> io;
+    std::string                                                       expect;
+    for (int i = 0; i < 1000; ++i) {
+        auto word = std::to_string(i) + " ";
+        neo::buffer_copy(io, neo::as_buffer(word));
+        expect += word;
+    }
+    std::string got(expect.size(), '\0');
+    CHECK(neo::buffer_copy(neo::as_buffer(got), io) == expect.size());
+    CHECK(got == expect);
+}
+
+TEST_CASE("Allocate bytes from the buffer pool") {
+    using pooled = neo::basic_bytes<neo::buffer_pool_allocator<std::byte>>;
+    auto b1      = pooled::copy(neo::as_buffer("I am a string", 13));
+    CHECK(b1.size() == 13);
+    auto b2 = b1;
+    CHECK(b1 == b2);
+    b2.resize(100000);
+    b2.resize(4);
+    b1.resize(4);
+    CHECK(b1 == b2);
+}
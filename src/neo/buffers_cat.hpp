@@ -71,7 +71,7 @@ public:
                 _iter_var = total_end{};
             } else {
                 auto&& nth_buffer = std::get<N>(*_bufs);
-                if (buffer_size(nth_buffer) == 0) {
+                if (buffer_is_empty(nth_buffer)) {
                     // The buffer at position N is empty. Skip over it
                     return _become<N + 1>();
                 }
@@ -139,6 +139,16 @@ public:
     constexpr iterator begin() const noexcept { return iterator(_bufs); }
     constexpr iterator end() const noexcept { return iterator(); }
 
+    /**
+     * Obtain the total size of the concatenated buffers, in bytes. This sums the sizes of the
+     * inner ranges directly rather than visiting every buffer through our own iterator, and will
+     * make use of inner ranges that know their own size (e.g. sized_buffer_range).
+     */
+    constexpr std::size_t buffer_size() const noexcept {
+        return std::apply([](const auto&... bufs) { return (neo::buffer_size(bufs) + ... + 0); },
+                          _bufs);
+    }
+
     constexpr const buffer_tuple& tuple() const& noexcept { return _bufs; }
     constexpr buffer_tuple&&      tuple() && noexcept { return std::move(_bufs); }
 };
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <neo/buffer_algorithm/compare.hpp>
 #include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffer_algorithm/fill.hpp>
 #include <neo/buffer_algorithm/size.hpp>
 #include <neo/const_buffer.hpp>
 #include <neo/mutable_buffer.hpp>
@@ -76,7 +78,9 @@ private:
         }
 
         // Free the old buffer
-        alloc_traits::deallocate(_alloc, old_ptr, old_size);
+        if (old_ptr != nullptr) {
+            alloc_traits::deallocate(_alloc, old_ptr, old_size);
+        }
 
         // Return a pointer to the beginning of the new tail of the buffer if it
         // has grown, otherwise just the pointer to the end.
@@ -85,7 +89,9 @@ private:
     }
 
     constexpr void _clear() noexcept {
-        alloc_traits::deallocate(_alloc, _bytes_ptr, _size);
+        if (_bytes_ptr != nullptr) {
+            alloc_traits::deallocate(_alloc, _bytes_ptr, _size);
+        }
         _bytes_ptr = nullptr;
         _size      = 0;
     }
@@ -262,9 +268,7 @@ public:
      * Set every byte in the object to the given pattern byte.
      */
     constexpr void fill(value_type pat) noexcept {
-        for (auto it = data(), stop = data_end(); it != stop; ++it) {
-            *it = pat;
-        }
+        buffer_fill(mutable_buffer(data(), size()), pat);
     }
 
     /**
@@ -278,12 +282,8 @@ public:
      */
     constexpr pointer resize(size_type size, value_type pattern) noexcept {
         const auto tail_ptr = resize(size, uninit);
-
-        const auto stop = data_end();
-        for (auto it = tail_ptr; it != stop; ++it) {
-            *it = pattern;
-        }
-
+        buffer_fill(mutable_buffer(tail_ptr, static_cast<std::size_t>(data_end() - tail_ptr)),
+                    pattern);
         return tail_ptr;
     }
 
@@ -294,16 +294,7 @@ public:
 
     [[nodiscard]] constexpr friend bool operator==(const basic_bytes& lhs,
                                                    const_buffer       rhs) noexcept {
-        if (lhs.size() != rhs.size()) {
-            return false;
-        }
-        for (auto it = lhs.data(), stop = lhs.data_end(), rhs_it = rhs.data(); it != stop;
-             ++it, ++rhs_it) {
-            if (*it != *rhs_it) {
-                return false;
-            }
-        }
-        return true;
+        return buffer_equal(const_buffer(lhs), rhs);
     }
     [[nodiscard]] constexpr friend bool operator==(const basic_bytes& lhs,
                                                    const basic_bytes& rhs) noexcept {
@@ -39,3 +39,12 @@ TEST_CASE("Copy a string literal") {
     b1.resize(4);
     CHECK(b1 == b2);
 }
+
+TEST_CASE("Fill and grow with a pattern") {
+    neo::bytes bs(5, std::byte{'a'});
+    CHECK(bs == neo::as_buffer(std::string_view("aaaaa")));
+    bs.resize(8, std::byte{'b'});
+    CHECK(bs == neo::as_buffer(std::string_view("aaaaabbb")));
+    bs.fill(std::byte{'c'});
+    CHECK(bs == neo::as_buffer(std::string_view("cccccccc")));
+}
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <neo/bytewise_iterator.hpp>
+
+#include <neo/assert.hpp>
+#include <neo/iterator_concepts.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+namespace neo {
+
+/**
+ * These algorithms are equivalent to their namesakes in <algorithm>, but are specialized for
+ * bytewise_iterator. Rather than stepping through the bytes one-at-a-time (which must check for a
+ * buffer boundary on every increment), they walk the underlying buffers one contiguous segment at
+ * a time and run a tight loop over each segment (using the C memory functions where possible).
+ */
+
+namespace detail {
+
+template <typename T>
+constexpr inline bool is_bytewise_iterator_v = false;
+
+template <typename B>
+constexpr inline bool is_bytewise_iterator_v<bytewise_iterator<B>> = true;
+
+template <typename T>
+concept bytewise_iter = is_bytewise_iterator_v<std::remove_cvref_t<T>>;
+
+template <bytewise_iter It>
+std::size_t bytewise_distance(const It& first, const It& last) noexcept {
+    return static_cast<std::size_t>(first.distance_to(last));
+}
+
+/**
+ * Invoke `fn` with each contiguous segment of bytes in [first, first + count). If `fn` returns
+ * `false`, stops and returns `false`. `first` is advanced past every segment that was visited.
+ *
+ * There must be at least `count` bytes following `first`. If the bytes run out early, this stops
+ * and returns `false` rather than spinning on an empty segment.
+ */
+template <bytewise_iter It, typename Func>
+bool for_each_bytewise_segment(It& first, std::size_t count, Func&& fn) {
+    while (count != 0) {
+        auto       seg      = first.segment();
+        const auto seg_size = (std::min)(seg.size(), count);
+        neo_assert(expects,
+                   seg_size != 0,
+                   "Bytewise range ended before the requested number of bytes",
+                   count);
+        if (seg_size == 0 || !fn(seg.data(), seg_size)) {
+            return false;
+        }
+        first.skip_bytes(seg_size);
+        count -= seg_size;
+    }
+    return true;
+}
+
+/**
+ * Invoke `fn` with pairs of contiguous segments of equal size drawn from two bytewise iterators,
+ * covering `count` bytes from each. If `fn` returns `false`, stops and returns `false`. Both
+ * iterators are advanced past every segment pair that was visited.
+ *
+ * Both ranges must have at least `count` bytes. If either runs out early, this stops and returns
+ * `false` rather than spinning on an empty segment.
+ */
+template <bytewise_iter It1, bytewise_iter It2, typename Func>
+bool for_each_bytewise_segment_pair(It1& first1, It2& first2, std::size_t count, Func&& fn) {
+    while (count != 0) {
+        auto       seg1     = first1.segment();
+        auto       seg2     = first2.segment();
+        const auto seg_size = (std::min)({seg1.size(), seg2.size(), count});
+        neo_assert(expects,
+                   seg_size != 0,
+                   "Bytewise range ended before the requested number of bytes",
+                   count,
+                   seg1.size(),
+                   seg2.size());
+        if (seg_size == 0 || !fn(seg1.data(), seg2.data(), seg_size)) {
+            return false;
+        }
+        first1.skip_bytes(seg_size);
+        first2.skip_bytes(seg_size);
+        count -= seg_size;
+    }
+    return true;
+}
+
+}  // namespace detail
+
+/**
+ * Copy the bytes in [first, last) to `out`, returning the end of the output.
+ */
+template <typename Bufs, typename OutIter>
+OutIter bytewise_copy(bytewise_iterator<Bufs> first, bytewise_iterator<Bufs> last, OutIter out) {
+    if constexpr (detail::bytewise_iter<OutIter>) {
+        detail::for_each_bytewise_segment_pair(first,
+                                               out,
+                                               detail::bytewise_distance(first, last),
+                                               [](auto src, auto dest, std::size_t n) {
+                                                   std::memmove(dest, src, n);
+                                                   return true;
+                                               });
+    } else {
+        detail::for_each_bytewise_segment(first,
+                                          detail::bytewise_distance(first, last),
+                                          [&](auto ptr, std::size_t n) {
+                                              out = std::copy(ptr, ptr + n, out);
+                                              return true;
+                                          });
+    }
+    return out;
+}
+
+/**
+ * Find the first byte equal to `value` in [first, last). Returns `last` if there is no such byte.
+ */
+template <typename Bufs>
+bytewise_iterator<Bufs>
+bytewise_find(bytewise_iterator<Bufs> first, bytewise_iterator<Bufs> last, std::byte value) {
+    auto found = detail::for_each_bytewise_segment(  //
+        first,
+        detail::bytewise_distance(first, last),
+        [&](auto ptr, std::size_t n) {
+            auto hit = std::memchr(ptr, std::to_integer<int>(value), n);
+            if (hit == nullptr) {
+                return true;
+            }
+            // Step up to the found byte within this segment
+            first.skip_bytes(static_cast<std::size_t>(static_cast<const std::byte*>(hit) - ptr));
+            return false;
+        });
+    return found ? last : first;
+}
+
+/**
+ * Count the number of bytes equal to `value` in [first, last).
+ */
+template <typename Bufs>
+std::size_t
+bytewise_count(bytewise_iterator<Bufs> first, bytewise_iterator<Bufs> last, std::byte value) {
+    std::size_t count = 0;
+    detail::for_each_bytewise_segment(first,
+                                      detail::bytewise_distance(first, last),
+                                      [&](auto ptr, std::size_t n) {
+                                          count += static_cast<std::size_t>(
+                                              std::count(ptr, ptr + n, value));
+                                          return true;
+                                      });
+    return count;
+}
+
+/**
+ * Find the first position where [first1, last1) and the range beginning at `first2` differ.
+ * `first2` may be another bytewise_iterator or any input iterator of bytes.
+ */
+template <typename Bufs, typename Iter2>
+std::pair<bytewise_iterator<Bufs>, Iter2> bytewise_mismatch(bytewise_iterator<Bufs> first1,
+                                                            bytewise_iterator<Bufs> last1,
+                                                            Iter2                   first2) {
+    const auto count = detail::bytewise_distance(first1, last1);
+    if constexpr (detail::bytewise_iter<Iter2>) {
+        detail::for_each_bytewise_segment_pair(  //
+            first1,
+            first2,
+            count,
+            [&](auto ptr1, auto ptr2, std::size_t n) {
+                if (std::memcmp(ptr1, ptr2, n) == 0) {
+                    return true;
+                }
+                // There is a difference in this segment. Find it:
+                auto diff = static_cast<std::size_t>(std::mismatch(ptr1, ptr1 + n, ptr2).first
+                                                     - ptr1);
+                first1.skip_bytes(diff);
+                first2.skip_bytes(diff);
+                return false;
+            });
+    } else {
+        detail::for_each_bytewise_segment(  //
+            first1,
+            count,
+            [&](auto ptr, std::size_t n) {
+                auto [stop1, stop2] = std::mismatch(ptr, ptr + n, first2);
+                first2              = stop2;
+                if (stop1 == ptr + n) {
+                    return true;
+                }
+                first1.skip_bytes(static_cast<std::size_t>(stop1 - ptr));
+                return false;
+            });
+    }
+    return {first1, first2};
+}
+
+/**
+ * Determine whether the bytes in [first1, last1) are equal to those of the range beginning at
+ * `first2`. `first2` may be another bytewise_iterator or any input iterator of bytes.
+ */
+template <typename Bufs, typename Iter2>
+bool bytewise_equal(bytewise_iterator<Bufs> first1,
+                    bytewise_iterator<Bufs> last1,
+                    Iter2                   first2) {
+    return bytewise_mismatch(first1, last1, first2).first == last1;
+}
+
+/**
+ * Determine whether the bytes in [first1, last1) are equal to those in [first2, last2).
+ */
+template <typename Bufs1, typename Bufs2>
+bool bytewise_equal(bytewise_iterator<Bufs1> first1,
+                    bytewise_iterator<Bufs1> last1,
+                    bytewise_iterator<Bufs2> first2,
+                    bytewise_iterator<Bufs2> last2) {
+    if (detail::bytewise_distance(first1, last1) != detail::bytewise_distance(first2, last2)) {
+        return false;
+    }
+    return bytewise_equal(first1, last1, first2);
+}
+
+}  // namespace neo
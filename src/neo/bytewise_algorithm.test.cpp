@@ -0,0 +1,90 @@
+#include <neo/bytewise_algorithm.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+auto bufs = {
+    neo::const_buffer("first"),
+    neo::const_buffer(""),
+    neo::const_buffer("second"),
+    neo::const_buffer("third"),
+};
+
+}  // namespace
+
+TEST_CASE("Copy through a bytewise iterator") {
+    neo::bytewise_iterator it(bufs);
+
+    std::vector<std::byte> vec;
+    neo::bytewise_copy(it, it.end(), std::back_inserter(vec));
+    CHECK(std::string_view(neo::const_buffer(vec)) == "firstsecondthird");
+
+    // Copy a partial range
+    std::string str = "........";
+    auto        out = neo::bytewise_copy(it + 3, it + 9, neo::as_buffer(str).data());
+    CHECK(str == "stseco..");
+    CHECK(out == neo::as_buffer(str).data() + 6);
+
+    // Copy between two segmented ranges
+    std::string                      a = "1234", b = "567", c = "890123456";
+    std::vector<neo::mutable_buffer> dest_bufs
+        = {neo::as_buffer(a), neo::as_buffer(b), neo::as_buffer(c)};
+    neo::bytewise_iterator dest(dest_bufs);
+    auto                   dest_end = neo::bytewise_copy(it + 2, it.end(), dest);
+    CHECK(a == "rsts");
+    CHECK(b == "eco");
+    CHECK(c == "ndthird56");
+    CHECK((dest_end == dest + 14));
+}
+
+TEST_CASE("Find and count bytes") {
+    neo::bytewise_iterator it(bufs);
+    auto                   stop = it.end();
+
+    auto found = neo::bytewise_find(it, stop, std::byte{'c'});
+    CHECK(found == it + 7);
+    CHECK((char)*found == 'c');
+    found = neo::bytewise_find(it, stop, std::byte{'z'});
+    CHECK(found == stop);
+    found = neo::bytewise_find(it + 6, stop, std::byte{'t'});
+    CHECK(found == it + 11);
+
+    CHECK(neo::bytewise_count(it, stop, std::byte{'i'}) == 2);
+    CHECK(neo::bytewise_count(it, stop, std::byte{'d'}) == 2);
+    CHECK(neo::bytewise_count(it + 1, it + 8, std::byte{'s'}) == 2);
+}
+
+TEST_CASE("Compare bytewise ranges") {
+    neo::bytewise_iterator it(bufs);
+
+    auto other_bufs = {
+        neo::const_buffer("fi"),
+        neo::const_buffer("rstsec"),
+        neo::const_buffer("ondthirsty"),
+    };
+    neo::bytewise_iterator other(other_bufs);
+
+    CHECK(neo::bytewise_equal(it, it + 14, other));
+    CHECK_FALSE(neo::bytewise_equal(it, it.end(), other));
+    CHECK_FALSE(neo::bytewise_equal(it, it + 14, other, other.end()));
+
+    auto [m1, m2] = neo::bytewise_mismatch(it, it.end(), other);
+    CHECK(m1 == it + 15);
+    CHECK(m2 == other + 15);
+    CHECK((char)*m1 == 'd');
+    CHECK((char)*m2 == 's');
+
+    // Compare against a plain iterator
+    std::string str      = "firstsecondthing";
+    auto        strbytes = neo::as_buffer(str);
+    auto [n1, n2]        = neo::bytewise_mismatch(it, it.end(), strbytes.data());
+    CHECK(n1 == it + 14);
+    CHECK(n2 == strbytes.data() + 14);
+    CHECK(neo::bytewise_equal(it, it + 14, strbytes.data()));
+}
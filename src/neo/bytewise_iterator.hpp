@@ -122,6 +122,28 @@ public:
     }
 
     constexpr auto& dereference() const noexcept { return (*_cur)[_cur_buf_pos]; }
+
+    /**
+     * Obtain the contiguous remainder of the buffer that this iterator currently refers to,
+     * beginning at the current byte. Returns an empty buffer for a past-the-end iterator.
+     */
+    constexpr auto segment() const noexcept {
+        using buffer_type = std::remove_cvref_t<decltype(*_cur)>;
+        if (_cur == _stop) {
+            return buffer_type();
+        }
+        return buffer_type(*_cur) + _cur_buf_pos;
+    }
+
+    /**
+     * Advance the iterator forward by `n` bytes. Unlike `operator+=`, this is available for all
+     * bytewise_iterators, including those over forward-only buffer ranges.
+     */
+    constexpr void skip_bytes(std::size_t n) noexcept {
+        if (n != 0) {
+            _advance(n);
+        }
+    }
 };
 
 template <single_buffer T>
@@ -158,6 +180,9 @@ public:
 
     constexpr auto& dereference() const noexcept { return _buf[_idx]; }
 
+    constexpr auto segment() const noexcept { return _buf + _idx; }
+    constexpr void skip_bytes(std::size_t n) noexcept { advance(static_cast<std::ptrdiff_t>(n)); }
+
     constexpr std::ptrdiff_t distance_to(bytewise_iterator other) const noexcept {
         return other._idx - _idx;
     }
@@ -0,0 +1,525 @@
+#pragma once
+
+#include <neo/buffer_algorithm/transform.hpp>
+#include <neo/buffer_range.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/mutable_buffer.hpp>
+
+#include <neo/concepts.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE4_2__) && (defined(__x86_64__) || defined(_M_X64))
+#include <nmmintrin.h>
+#define NEO_CHECKSUM_HAS_SSE42_CRC32 1
+#endif
+
+namespace neo {
+
+// clang-format off
+/**
+ * A checksum_digest incrementally computes a checksum over a sequence of bytes.
+ */
+template <typename T>
+concept checksum_digest =
+    semiregular<T> &&
+    requires(T dig, const T cdig, const_buffer cb) {
+        dig.update(cb);
+        cdig.digest();
+    };
+// clang-format on
+
+namespace detail {
+
+/// Reflected CRC-32C (Castagnoli) polynomial
+constexpr std::uint32_t crc32c_poly = 0x82f63b78;
+
+constexpr std::uint32_t crc32c_byte_step(std::uint32_t crc) noexcept {
+    for (int bit = 0; bit < 8; ++bit) {
+        crc = (crc & 1) ? ((crc >> 1) ^ crc32c_poly) : (crc >> 1);
+    }
+    return crc;
+}
+
+/**
+ * Slicing-by-8 lookup tables for the portable CRC-32C implementation.
+ * `tab[0]` is the ordinary bytewise table, and `tab[k][b]` is the CRC of byte
+ * `b` followed by `k` zero bytes.
+ */
+constexpr auto make_crc32c_tables() noexcept {
+    std::array<std::array<std::uint32_t, 256>, 8> tab{};
+    for (std::uint32_t b = 0; b < 256; ++b) {
+        tab[0][b] = crc32c_byte_step(b);
+    }
+    for (std::size_t k = 1; k < 8; ++k) {
+        for (std::size_t b = 0; b < 256; ++b) {
+            const auto prev = tab[k - 1][b];
+            tab[k][b]       = (prev >> 8) ^ tab[0][prev & 0xff];
+        }
+    }
+    return tab;
+}
+
+inline constexpr auto crc32c_tables = make_crc32c_tables();
+
+/**
+ * Update the raw (non-inverted) CRC-32C register `crc` with the given bytes
+ * using the portable slicing-by-8 algorithm.
+ */
+inline std::uint32_t
+crc32c_update_portable(std::uint32_t crc, const std::byte* p, std::size_t n) noexcept {
+    const auto& tab = crc32c_tables;
+    for (; n >= 8; n -= 8, p += 8) {
+        const auto b = [&](int i) { return std::to_integer<std::uint32_t>(p[i]); };
+        const auto lo = crc ^ (b(0) | (b(1) << 8) | (b(2) << 16) | (b(3) << 24));
+        crc           = tab[7][lo & 0xff] ^ tab[6][(lo >> 8) & 0xff] ^ tab[5][(lo >> 16) & 0xff]
+            ^ tab[4][lo >> 24] ^ tab[3][b(4)] ^ tab[2][b(5)] ^ tab[1][b(6)] ^ tab[0][b(7)];
+    }
+    for (; n; --n, ++p) {
+        crc = (crc >> 8) ^ tab[0][(crc ^ std::to_integer<std::uint32_t>(*p)) & 0xff];
+    }
+    return crc;
+}
+
+#if NEO_CHECKSUM_HAS_SSE42_CRC32
+
+/// The length of each of the three interleaved streams of the hardware CRC
+constexpr std::size_t crc32c_lane_size = 1024;
+
+/**
+ * Tables to advance a raw CRC-32C register over `crc32c_lane_size` zero bytes:
+ * `tab[k][b]` is the result for a register whose only nonzero byte is `b` at
+ * byte position `k`. The operation is linear, so the results for each byte of
+ * the register can be combined with XOR.
+ */
+constexpr auto make_crc32c_shift_tables() noexcept {
+    std::array<std::uint32_t, 32> basis{};
+    for (std::size_t bit = 0; bit < 32; ++bit) {
+        std::uint32_t crc = std::uint32_t(1) << bit;
+        for (std::size_t i = 0; i < crc32c_lane_size; ++i) {
+            crc = crc32c_byte_step(crc);
+        }
+        basis[bit] = crc;
+    }
+    std::array<std::array<std::uint32_t, 256>, 4> tab{};
+    for (std::size_t k = 0; k < 4; ++k) {
+        for (std::size_t b = 0; b < 256; ++b) {
+            std::uint32_t acc = 0;
+            for (std::size_t bit = 0; bit < 8; ++bit) {
+                if (b & (std::size_t(1) << bit)) {
+                    acc ^= basis[k * 8 + bit];
+                }
+            }
+            tab[k][b] = acc;
+        }
+    }
+    return tab;
+}
+
+inline constexpr auto crc32c_shift_tables = make_crc32c_shift_tables();
+
+inline std::uint32_t crc32c_shift_lane(std::uint32_t crc) noexcept {
+    const auto& tab = crc32c_shift_tables;
+    return tab[0][crc & 0xff] ^ tab[1][(crc >> 8) & 0xff] ^ tab[2][(crc >> 16) & 0xff]
+        ^ tab[3][crc >> 24];
+}
+
+/**
+ * Update the raw CRC-32C register using the SSE4.2 `crc32` instruction. Large
+ * inputs are split into three independent streams to hide the latency of the
+ * instruction, and the partial results are recombined with a table-driven
+ * shift.
+ */
+inline std::uint32_t
+crc32c_update_hw(std::uint32_t crc32, const std::byte* p, std::size_t n) noexcept {
+    std::uint64_t crc = crc32;
+    while (n >= 3 * crc32c_lane_size) {
+        std::uint64_t crc_a = crc, crc_b = 0, crc_c = 0;
+        for (std::size_t i = 0; i < crc32c_lane_size; i += 8) {
+            std::uint64_t wa, wb, wc;
+            std::memcpy(&wa, p + i, 8);
+            std::memcpy(&wb, p + i + crc32c_lane_size, 8);
+            std::memcpy(&wc, p + i + 2 * crc32c_lane_size, 8);
+            crc_a = _mm_crc32_u64(crc_a, wa);
+            crc_b = _mm_crc32_u64(crc_b, wb);
+            crc_c = _mm_crc32_u64(crc_c, wc);
+        }
+        crc = crc32c_shift_lane(static_cast<std::uint32_t>(crc_a)) ^ crc_b;
+        crc = crc32c_shift_lane(static_cast<std::uint32_t>(crc)) ^ crc_c;
+        p += 3 * crc32c_lane_size;
+        n -= 3 * crc32c_lane_size;
+    }
+    for (; n >= 8; n -= 8, p += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, p, 8);
+        crc = _mm_crc32_u64(crc, word);
+    }
+    auto crc_narrow = static_cast<std::uint32_t>(crc);
+    for (; n; --n, ++p) {
+        crc_narrow = _mm_crc32_u8(crc_narrow, std::to_integer<unsigned char>(*p));
+    }
+    return crc_narrow;
+}
+
+#endif
+
+inline std::uint32_t crc32c_update(std::uint32_t crc, const std::byte* p, std::size_t n) noexcept {
+#if NEO_CHECKSUM_HAS_SSE42_CRC32
+    return crc32c_update_hw(crc, p, n);
+#else
+    return crc32c_update_portable(crc, p, n);
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * Incrementally computes the CRC-32C (Castagnoli) checksum of a sequence of
+ * bytes, as used by iSCSI, ext4, and many storage formats.
+ *
+ * Uses the SSE4.2 `crc32` instruction when it is enabled at compile time, and a
+ * portable slicing-by-8 table otherwise.
+ */
+class crc32c_digest {
+    std::uint32_t _crc = 0xffff'ffff;
+
+public:
+    /// Feed more bytes into the checksum
+    void update(const_buffer cb) noexcept {
+        _crc = detail::crc32c_update(_crc, cb.data(), cb.size());
+    }
+
+    /// Obtain the checksum of all bytes given so far
+    constexpr std::uint32_t digest() const noexcept { return ~_crc; }
+};
+
+/**
+ * Incrementally computes the 32-bit xxHash (XXH32) of a sequence of bytes.
+ */
+class xxhash32_digest {
+    static constexpr std::uint32_t prime1 = 0x9e37'79b1;
+    static constexpr std::uint32_t prime2 = 0x85eb'ca77;
+    static constexpr std::uint32_t prime3 = 0xc2b2'ae3d;
+    static constexpr std::uint32_t prime4 = 0x27d4'eb2f;
+    static constexpr std::uint32_t prime5 = 0x1656'67b1;
+
+    std::array<std::uint32_t, 4> _acc;
+    std::uint32_t                _seed;
+    std::uint64_t                _total_len = 0;
+    std::array<std::byte, 16>    _stripe{};
+    std::size_t                  _stripe_len = 0;
+
+    static std::uint32_t _read32(const std::byte* p) noexcept {
+        // xxHash is defined in terms of little-endian reads
+        std::uint32_t ret = 0;
+        for (int i = 3; i >= 0; --i) {
+            ret = (ret << 8) | std::to_integer<std::uint32_t>(p[i]);
+        }
+        return ret;
+    }
+
+    static constexpr std::uint32_t _round(std::uint32_t acc, std::uint32_t input) noexcept {
+        acc += input * prime2;
+        acc = std::rotl(acc, 13);
+        return acc * prime1;
+    }
+
+    void _consume_stripes(const std::byte* p, std::size_t n_stripes) noexcept {
+        auto [a0, a1, a2, a3] = _acc;
+        for (; n_stripes; --n_stripes, p += 16) {
+            a0 = _round(a0, _read32(p));
+            a1 = _round(a1, _read32(p + 4));
+            a2 = _round(a2, _read32(p + 8));
+            a3 = _round(a3, _read32(p + 12));
+        }
+        _acc = {a0, a1, a2, a3};
+    }
+
+public:
+    constexpr xxhash32_digest() noexcept
+        : xxhash32_digest(0) {}
+
+    constexpr explicit xxhash32_digest(std::uint32_t seed) noexcept
+        : _acc{seed + prime1 + prime2, seed + prime2, seed, seed - prime1}
+        , _seed(seed) {}
+
+    /// Feed more bytes into the hash
+    void update(const_buffer cb) noexcept {
+        _total_len += cb.size();
+        if (_stripe_len != 0) {
+            // Complete the partial stripe from a prior update
+            const auto n_fill = (std::min)(16 - _stripe_len, cb.size());
+            std::copy_n(cb.data(), n_fill, _stripe.data() + _stripe_len);
+            _stripe_len += n_fill;
+            cb += n_fill;
+            if (_stripe_len < 16) {
+                return;
+            }
+            _consume_stripes(_stripe.data(), 1);
+            _stripe_len = 0;
+        }
+        const auto n_stripes = cb.size() / 16;
+        _consume_stripes(cb.data(), n_stripes);
+        cb += n_stripes * 16;
+        std::copy_n(cb.data(), cb.size(), _stripe.data());
+        _stripe_len = cb.size();
+    }
+
+    /// Obtain the hash of all bytes given so far
+    std::uint32_t digest() const noexcept {
+        std::uint32_t h;
+        if (_total_len >= 16) {
+            const auto& [a0, a1, a2, a3] = _acc;
+            h = std::rotl(a0, 1) + std::rotl(a1, 7) + std::rotl(a2, 12) + std::rotl(a3, 18);
+        } else {
+            h = _seed + prime5;
+        }
+        // The length is mixed in modulo 2^32
+        h += static_cast<std::uint32_t>(_total_len);
+
+        const std::byte* p    = _stripe.data();
+        const std::byte* stop = p + _stripe_len;
+        for (; stop - p >= 4; p += 4) {
+            h += _read32(p) * prime3;
+            h = std::rotl(h, 17) * prime4;
+        }
+        for (; p != stop; ++p) {
+            h += std::to_integer<std::uint32_t>(*p) * prime5;
+            h = std::rotl(h, 11) * prime1;
+        }
+
+        h ^= h >> 15;
+        h *= prime2;
+        h ^= h >> 13;
+        h *= prime3;
+        h ^= h >> 16;
+        return h;
+    }
+};
+
+/**
+ * Incrementally computes the 64-bit xxHash (XXH64) of a sequence of bytes.
+ */
+class xxhash64_digest {
+    static constexpr std::uint64_t prime1 = 0x9e37'79b1'85eb'ca87;
+    static constexpr std::uint64_t prime2 = 0xc2b2'ae3d'27d4'eb4f;
+    static constexpr std::uint64_t prime3 = 0x1656'67b1'9e37'79f9;
+    static constexpr std::uint64_t prime4 = 0x85eb'ca77'c2b2'ae63;
+    static constexpr std::uint64_t prime5 = 0x27d4'eb2f'1656'67c5;
+
+    std::array<std::uint64_t, 4> _acc;
+    std::uint64_t                _seed;
+    std::uint64_t                _total_len = 0;
+    std::array<std::byte, 32>    _stripe{};
+    std::size_t                  _stripe_len = 0;
+
+    static std::uint64_t _read64(const std::byte* p) noexcept {
+        // xxHash is defined in terms of little-endian reads
+        std::uint64_t ret = 0;
+        for (int i = 7; i >= 0; --i) {
+            ret = (ret << 8) | std::to_integer<std::uint64_t>(p[i]);
+        }
+        return ret;
+    }
+
+    static std::uint32_t _read32(const std::byte* p) noexcept {
+        std::uint32_t ret = 0;
+        for (int i = 3; i >= 0; --i) {
+            ret = (ret << 8) | std::to_integer<std::uint32_t>(p[i]);
+        }
+        return ret;
+    }
+
+    static constexpr std::uint64_t _round(std::uint64_t acc, std::uint64_t input) noexcept {
+        acc += input * prime2;
+        acc = std::rotl(acc, 31);
+        return acc * prime1;
+    }
+
+    static constexpr std::uint64_t _merge_round(std::uint64_t acc, std::uint64_t val) noexcept {
+        acc ^= _round(0, val);
+        return acc * prime1 + prime4;
+    }
+
+    void _consume_stripes(const std::byte* p, std::size_t n_stripes) noexcept {
+        auto [a0, a1, a2, a3] = _acc;
+        for (; n_stripes; --n_stripes, p += 32) {
+            a0 = _round(a0, _read64(p));
+            a1 = _round(a1, _read64(p + 8));
+            a2 = _round(a2, _read64(p + 16));
+            a3 = _round(a3, _read64(p + 24));
+        }
+        _acc = {a0, a1, a2, a3};
+    }
+
+public:
+    constexpr xxhash64_digest() noexcept
+        : xxhash64_digest(0) {}
+
+    constexpr explicit xxhash64_digest(std::uint64_t seed) noexcept
+        : _acc{seed + prime1 + prime2, seed + prime2, seed, seed - prime1}
+        , _seed(seed) {}
+
+    /// Feed more bytes into the hash
+    void update(const_buffer cb) noexcept {
+        _total_len += cb.size();
+        if (_stripe_len != 0) {
+            // Complete the partial stripe from a prior update
+            const auto n_fill = (std::min)(32 - _stripe_len, cb.size());
+            std::copy_n(cb.data(), n_fill, _stripe.data() + _stripe_len);
+            _stripe_len += n_fill;
+            cb += n_fill;
+            if (_stripe_len < 32) {
+                return;
+            }
+            _consume_stripes(_stripe.data(), 1);
+            _stripe_len = 0;
+        }
+        const auto n_stripes = cb.size() / 32;
+        _consume_stripes(cb.data(), n_stripes);
+        cb += n_stripes * 32;
+        std::copy_n(cb.data(), cb.size(), _stripe.data());
+        _stripe_len = cb.size();
+    }
+
+    /// Obtain the hash of all bytes given so far
+    std::uint64_t digest() const noexcept {
+        std::uint64_t h;
+        if (_total_len >= 32) {
+            const auto& [a0, a1, a2, a3] = _acc;
+            h = std::rotl(a0, 1) + std::rotl(a1, 7) + std::rotl(a2, 12) + std::rotl(a3, 18);
+            h = _merge_round(h, a0);
+            h = _merge_round(h, a1);
+            h = _merge_round(h, a2);
+            h = _merge_round(h, a3);
+        } else {
+            h = _seed + prime5;
+        }
+        h += _total_len;
+
+        const std::byte* p    = _stripe.data();
+        const std::byte* stop = p + _stripe_len;
+        for (; stop - p >= 8; p += 8) {
+            h ^= _round(0, _read64(p));
+            h = std::rotl(h, 27) * prime1 + prime4;
+        }
+        if (stop - p >= 4) {
+            h ^= std::uint64_t(_read32(p)) * prime1;
+            h = std::rotl(h, 23) * prime2 + prime3;
+            p += 4;
+        }
+        for (; p != stop; ++p) {
+            h ^= std::to_integer<std::uint64_t>(*p) * prime5;
+            h = std::rotl(h, 11) * prime1;
+        }
+
+        h ^= h >> 33;
+        h *= prime2;
+        h ^= h >> 29;
+        h *= prime3;
+        h ^= h >> 32;
+        return h;
+    }
+};
+
+/**
+ * Compute the checksum of the given buffer range using the given digest type.
+ */
+template <checksum_digest Digest, buffer_range Bufs>
+auto buffer_checksum(const Bufs& bufs, Digest dig = Digest()) noexcept {
+    for (const_buffer cb : bufs) {
+        dig.update(cb);
+    }
+    return dig.digest();
+}
+
+/**
+ * A buffer_transformer that copies its input to its output unmodified, and
+ * feeds the copied bytes into a checksum digest. Use with buffer_transform_sink
+ * or buffer_transform_source to checksum data as it is being copied.
+ */
+template <checksum_digest Digest>
+class checksum_transformer {
+    Digest _digest;
+
+public:
+    constexpr checksum_transformer() = default;
+    constexpr explicit checksum_transformer(Digest d) noexcept
+        : _digest(d) {}
+
+    /// The digest of the data that has passed through so far
+    constexpr const Digest& digest() const noexcept { return _digest; }
+
+    simple_transform_result operator()(mutable_buffer out, const_buffer in) noexcept {
+        const auto n = (std::min)(out.size(), in.size());
+        if (out.data() != in.data()) {
+            std::copy_n(in.data(), n, out.data());
+        }
+        _digest.update(const_buffer(out.data(), n));
+        return {n, n, false};
+    }
+
+    /// The data passes through unchanged, so it only needs to be digested
+    std::size_t passthrough(const_buffer in) noexcept {
+        _digest.update(in);
+        return in.size();
+    }
+};
+
+template <checksum_digest Digest>
+constexpr bool buffer_transformer_is_inplace_safe_v<checksum_transformer<Digest>> = true;
+
+template <typename D>
+checksum_transformer(D) -> checksum_transformer<D>;
+
+/**
+ * A buffer_sink that discards its data, only feeding it into a checksum
+ * digest.
+ */
+template <checksum_digest Digest, std::size_t BufferSize = 1024 * 4>
+class checksum_sink {
+    Digest                            _digest;
+    std::array<std::byte, BufferSize> _buf;
+
+public:
+    constexpr checksum_sink() = default;
+    constexpr explicit checksum_sink(Digest d) noexcept
+        : _digest(d) {}
+
+    /// The digest of the data that has been committed so far
+    constexpr const Digest& digest() const noexcept { return _digest; }
+
+    /**
+     * Obtain a scratch buffer to write into. The returned buffer may be smaller
+     * than requested.
+     */
+    constexpr mutable_buffer prepare(std::size_t n) noexcept {
+        return mutable_buffer(_buf.data(), (std::min)(n, _buf.size()));
+    }
+
+    void commit(std::size_t n) noexcept {
+        neo_assert(expects,
+                   n <= _buf.size(),
+                   "Committed more bytes to a checksum_sink than were prepared",
+                   n,
+                   _buf.size());
+        _digest.update(const_buffer(_buf.data(), n));
+    }
+};
+
+template <typename D>
+checksum_sink(D) -> checksum_sink<D>;
+
+using crc32c_transformer   = checksum_transformer<crc32c_digest>;
+using xxhash32_transformer = checksum_transformer<xxhash32_digest>;
+using xxhash64_transformer = checksum_transformer<xxhash64_digest>;
+using crc32c_sink          = checksum_sink<crc32c_digest>;
+using xxhash32_sink        = checksum_sink<xxhash32_digest>;
+using xxhash64_sink        = checksum_sink<xxhash64_digest>;
+
+}  // namespace neo
@@ -0,0 +1,116 @@
+#include <neo/checksum.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/string_io.hpp>
+#include <neo/test_concept.hpp>
+#include <neo/transform_io.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <string_view>
+
+NEO_TEST_CONCEPT(neo::checksum_digest<neo::crc32c_digest>);
+NEO_TEST_CONCEPT(neo::checksum_digest<neo::xxhash32_digest>);
+NEO_TEST_CONCEPT(neo::checksum_digest<neo::xxhash64_digest>);
+NEO_TEST_CONCEPT(neo::buffer_transformer<neo::crc32c_transformer>);
+NEO_TEST_CONCEPT(neo::buffer_transformer<neo::xxhash64_transformer>);
+NEO_TEST_CONCEPT(neo::buffer_sink<neo::crc32c_sink>);
+NEO_TEST_CONCEPT(neo::buffer_sink<neo::xxhash64_sink>);
+
+namespace {
+
+std::string make_input(std::size_t size) {
+    std::string ret;
+    for (std::size_t i = 0; i < size; ++i) {
+        ret.push_back(static_cast<char>(i * 7 + 3));
+    }
+    return ret;
+}
+
+}  // namespace
+
+TEST_CASE("CRC-32C") {
+    using namespace std::literals;
+    CHECK(neo::crc32c_digest{}.digest() == 0);
+    CHECK(neo::buffer_checksum<neo::crc32c_digest>(neo::as_buffer("123456789"sv)) == 0xe306'9283);
+    const std::string zeros(32, '\0');
+    CHECK(neo::buffer_checksum<neo::crc32c_digest>(neo::as_buffer(zeros)) == 0x8a91'36aa);
+    // Long enough to use interleaved streams, if available
+    const auto input = make_input(10000);
+    CHECK(neo::buffer_checksum<neo::crc32c_digest>(neo::as_buffer(input)) == 0x4eb7'2655);
+
+    // Updating in pieces gives the same result
+    neo::crc32c_digest dig;
+    std::size_t        pos = 0;
+    for (std::size_t len = 1; pos < input.size(); len = len * 2 + 1) {
+        auto part = neo::as_buffer(input) + pos;
+        part      = neo::const_buffer(part.data(), (std::min)(len, part.size()));
+        dig.update(part);
+        pos += part.size();
+    }
+    CHECK(dig.digest() == 0x4eb7'2655);
+}
+
+TEST_CASE("xxHash32") {
+    using namespace std::literals;
+    CHECK(neo::xxhash32_digest{}.digest() == 0x02cc'5d05);
+    CHECK(neo::buffer_checksum<neo::xxhash32_digest>(neo::as_buffer("abc"sv)) == 0x32d1'53ff);
+    const auto input = make_input(10000);
+    CHECK(neo::buffer_checksum<neo::xxhash32_digest>(neo::as_buffer(input, 100)) == 0x7309'1a4d);
+    CHECK(neo::buffer_checksum<neo::xxhash32_digest>(neo::as_buffer(input)) == 0xff59'cea3);
+    CHECK(neo::buffer_checksum(neo::as_buffer(input), neo::xxhash32_digest{42}) == 0x3507'b43e);
+
+    neo::xxhash32_digest dig;
+    std::size_t          pos = 0;
+    for (std::size_t len = 1; pos < input.size(); len = len * 2 + 1) {
+        auto part = neo::as_buffer(input) + pos;
+        part      = neo::const_buffer(part.data(), (std::min)(len, part.size()));
+        dig.update(part);
+        pos += part.size();
+    }
+    CHECK(dig.digest() == 0xff59'cea3);
+}
+
+TEST_CASE("xxHash64") {
+    using namespace std::literals;
+    CHECK(neo::xxhash64_digest{}.digest() == 0xef46'db37'51d8'e999);
+    CHECK(neo::buffer_checksum<neo::xxhash64_digest>(neo::as_buffer("abc"sv))
+          == 0x44bc'2cf5'ad77'0999);
+    const auto input = make_input(10000);
+    CHECK(neo::buffer_checksum<neo::xxhash64_digest>(neo::as_buffer(input, 100))
+          == 0xa61f'8d4c'170f'e531);
+    CHECK(neo::buffer_checksum<neo::xxhash64_digest>(neo::as_buffer(input))
+          == 0xb195'585f'9792'dbca);
+    CHECK(neo::buffer_checksum(neo::as_buffer(input), neo::xxhash64_digest{42})
+          == 0x8200'df7f'e32c'2d6f);
+
+    neo::xxhash64_digest dig;
+    std::size_t          pos = 0;
+    for (std::size_t len = 1; pos < input.size(); len = len * 2 + 1) {
+        auto part = neo::as_buffer(input) + pos;
+        part      = neo::const_buffer(part.data(), (std::min)(len, part.size()));
+        dig.update(part);
+        pos += part.size();
+    }
+    CHECK(dig.digest() == 0xb195'585f'9792'dbca);
+}
+
+TEST_CASE("Checksum while copying") {
+    const auto                 input = make_input(10000);
+    neo::string_dynbuf_io      out;
+    neo::buffer_transform_sink sink{out, neo::crc32c_transformer{}};
+    neo::buffer_copy(sink, neo::as_buffer(input));
+    out.shrink_uncommitted();
+    CHECK(out.read_area_view() == input);
+    CHECK(sink.transformer().digest().digest() == 0x4eb7'2655);
+}
+
+TEST_CASE("Checksum-only sink") {
+    const auto         input = make_input(10000);
+    neo::xxhash64_sink sink;
+    auto               n = neo::buffer_copy(sink, neo::as_buffer(input));
+    CHECK(n == input.size());
+    CHECK(sink.digest().digest() == 0xb195'585f'9792'dbca);
+}
@@ -0,0 +1,224 @@
+#pragma once
+
+#include "./buffer_pool.hpp"
+#include "./const_buffer.hpp"
+#include "./mutable_buffer.hpp"
+
+#include <neo/assert.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+namespace neo {
+
+/**
+ * A range of buffers that view a span of bytes in a sequence of equally-sized
+ * chunks. This is the range returned by `chunked_dynamic_buffer::data()`.
+ */
+template <typename Buffer, typename ChunkIter>
+class chunked_buffer_view {
+    ChunkIter   _chunk;
+    std::size_t _offset     = 0;
+    std::size_t _size       = 0;
+    std::size_t _chunk_size = 0;
+
+public:
+    class iterator {
+        ChunkIter   _chunk{};
+        std::size_t _offset     = 0;
+        std::size_t _remaining  = 0;
+        std::size_t _chunk_size = 0;
+
+        std::size_t _part_size() const noexcept {
+            return (std::min)(_remaining, _chunk_size - _offset);
+        }
+
+    public:
+        using iterator_concept  = std::forward_iterator_tag;
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = Buffer;
+        using reference         = Buffer;
+        using pointer           = void;
+
+        iterator() = default;
+        iterator(ChunkIter chunk, std::size_t offset, std::size_t size, std::size_t cs) noexcept
+            : _chunk(chunk)
+            , _offset(offset)
+            , _remaining(size)
+            , _chunk_size(cs) {}
+
+        Buffer operator*() const noexcept { return Buffer(*_chunk + _offset, _part_size()); }
+
+        iterator& operator++() noexcept {
+            _remaining -= _part_size();
+            _offset = 0;
+            ++_chunk;
+            return *this;
+        }
+        iterator operator++(int) noexcept {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const iterator& o) const noexcept { return _remaining == o._remaining; }
+        bool operator==(std::default_sentinel_t) const noexcept { return _remaining == 0; }
+    };
+
+    chunked_buffer_view() = default;
+    chunked_buffer_view(ChunkIter chunk, std::size_t offset, std::size_t size, std::size_t cs)
+        : _chunk(chunk)
+        , _offset(offset)
+        , _size(size)
+        , _chunk_size(cs) {}
+
+    iterator begin() const noexcept { return iterator(_chunk, _offset, _size, _chunk_size); }
+    std::default_sentinel_t end() const noexcept { return {}; }
+};
+
+/**
+ * A dynamic buffer that stores its data in a sequence of fixed-size chunks
+ * drawn from buffer_pool::shared(). Growing never moves existing data, and
+ * consuming from the front gives emptied chunks straight back to the pool, so
+ * a long-lived stream reuses a small working set of chunks.
+ *
+ * The buffers returned by `data()` and `grow()` are ranges that may span
+ * several chunks.
+ */
+class chunked_dynamic_buffer {
+    std::deque<std::byte*> _chunks;
+    std::size_t            _chunk_size;
+    // The offset of the first byte within the first chunk
+    std::size_t _begin = 0;
+    std::size_t _size  = 0;
+
+    void _release_from(std::size_t n_keep) noexcept {
+        while (_chunks.size() > n_keep) {
+            buffer_pool::shared().deallocate(mutable_buffer(_chunks.back(), _chunk_size));
+            _chunks.pop_back();
+        }
+    }
+
+    template <typename Buffer, typename Chunks>
+    static auto
+    _view(Chunks& chunks, std::size_t chunk_size, std::size_t pos, std::size_t size) noexcept {
+        using view = chunked_buffer_view<Buffer, typename Chunks::const_iterator>;
+        if (size == 0) {
+            return view();
+        }
+        auto first = chunks.cbegin() + static_cast<std::ptrdiff_t>(pos / chunk_size);
+        return view(first, pos % chunk_size, size, chunk_size);
+    }
+
+public:
+    /**
+     * Create a buffer whose chunks are `chunk_size` bytes, rounded up to one of
+     * the buffer_pool's size classes.
+     */
+    explicit chunked_dynamic_buffer(std::size_t chunk_size = buffer_pool::size_classes[0])
+        : _chunk_size(buffer_pool::block_size_for(chunk_size)) {
+        neo_assert(expects,
+                   buffer_pool::size_class_for(chunk_size) != buffer_pool::n_size_classes,
+                   "chunked_dynamic_buffer chunks must fit in one of the buffer_pool's size "
+                   "classes",
+                   chunk_size);
+    }
+
+    chunked_dynamic_buffer(chunked_dynamic_buffer&& o) noexcept
+        : _chunks(std::move(o._chunks))
+        , _chunk_size(o._chunk_size)
+        , _begin(std::exchange(o._begin, 0))
+        , _size(std::exchange(o._size, 0)) {
+        o._chunks.clear();
+    }
+
+    chunked_dynamic_buffer& operator=(chunked_dynamic_buffer&& o) noexcept {
+        if (this != &o) {
+            _release_from(0);
+            _chunks     = std::move(o._chunks);
+            _chunk_size = o._chunk_size;
+            _begin      = std::exchange(o._begin, 0);
+            _size       = std::exchange(o._size, 0);
+            o._chunks.clear();
+        }
+        return *this;
+    }
+
+    ~chunked_dynamic_buffer() { _release_from(0); }
+
+    std::size_t chunk_size() const noexcept { return _chunk_size; }
+    std::size_t chunk_count() const noexcept { return _chunks.size(); }
+
+    std::size_t size() const noexcept { return _size; }
+    std::size_t max_size() const noexcept { return std::numeric_limits<std::size_t>::max(); }
+    std::size_t capacity() const noexcept { return _chunks.size() * _chunk_size - _begin; }
+
+    auto data(std::size_t pos, std::size_t size_) noexcept {
+        neo_assert(expects,
+                   pos + size_ <= size(),
+                   "Cannot read more bytes than are contained in a dynamic buffer",
+                   pos,
+                   size_,
+                   this->size());
+        return _view<mutable_buffer>(_chunks, _chunk_size, _begin + pos, size_);
+    }
+
+    auto data(std::size_t pos, std::size_t size_) const noexcept {
+        neo_assert(expects,
+                   pos + size_ <= size(),
+                   "Cannot read more bytes than are contained in a dynamic buffer",
+                   pos,
+                   size_,
+                   this->size());
+        return _view<const_buffer>(_chunks, _chunk_size, _begin + pos, size_);
+    }
+
+    auto grow(std::size_t n) {
+        while (capacity() - _size < n) {
+            _chunks.push_back(buffer_pool::shared().allocate(_chunk_size).data());
+        }
+        const auto prev_size = _size;
+        _size += n;
+        return data(prev_size, n);
+    }
+
+    void shrink(std::size_t n) noexcept {
+        neo_assert(expects,
+                   n <= size(),
+                   "Cannot shrink a dynamic buffer below its own size",
+                   n,
+                   this->size());
+        _size -= n;
+        // Keep the chunk that holds the end of the data, and release the rest
+        _release_from((_begin + _size + _chunk_size - 1) / _chunk_size);
+        if (_size == 0) {
+            _begin = 0;
+        }
+    }
+
+    void consume(std::size_t n) noexcept {
+        neo_assert(expects,
+                   n <= size(),
+                   "Cannot consume more bytes than are contained in a dynamic buffer",
+                   n,
+                   this->size());
+        _begin += n;
+        _size -= n;
+        // Give the emptied chunks back to the pool
+        while (_begin >= _chunk_size) {
+            buffer_pool::shared().deallocate(mutable_buffer(_chunks.front(), _chunk_size));
+            _chunks.pop_front();
+            _begin -= _chunk_size;
+        }
+        if (_size == 0) {
+            _begin = 0;
+        }
+    }
+};
+
+}  // namespace neo
@@ -0,0 +1,74 @@
+#include <neo/chunked_dynamic_buffer.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffer_algorithm/size.hpp>
+#include <neo/dynamic_buffer.hpp>
+#include <neo/dynbuf_io.hpp>
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+
+NEO_TEST_CONCEPT(neo::dynamic_buffer<neo::chunked_dynamic_buffer>);
+NEO_TEST_CONCEPT(neo::as_dynamic_buffer_convertible<neo::chunked_dynamic_buffer&>);
+
+TEST_CASE("Grow and consume a chunked dynamic buffer") {
+    neo::chunked_dynamic_buffer buf;
+    CHECK(buf.chunk_size() == 4096);
+    CHECK(buf.capacity() == 0);
+
+    auto area = buf.grow(10000);
+    CHECK(neo::buffer_size(area) == 10000);
+    CHECK(buf.chunk_count() == 3);
+    CHECK(std::ranges::distance(area) == 3);
+
+    std::string input;
+    for (int i = 0; input.size() < 10000; ++i) {
+        input += std::to_string(i) + ",";
+    }
+    input.resize(10000);
+    CHECK(neo::buffer_copy(area, neo::as_buffer(input)) == 10000);
+
+    // Reading across the chunk boundaries gives back what we wrote
+    std::string got(5000, '\0');
+    CHECK(neo::buffer_copy(neo::as_buffer(got), buf.data(3000, 5000)) == 5000);
+    CHECK(got == input.substr(3000, 5000));
+
+    // Consuming the front releases emptied chunks
+    buf.consume(5000);
+    CHECK(buf.size() == 5000);
+    CHECK(buf.chunk_count() == 2);
+    CHECK(buf.capacity() == 8192 - (5000 - 4096));
+
+    buf.shrink(4000);
+    CHECK(buf.size() == 1000);
+    CHECK(buf.chunk_count() == 1);
+
+    buf.consume(1000);
+    CHECK(buf.size() == 0);
+    CHECK(buf.capacity() == 4096);
+}
+
+TEST_CASE("Stream through a chunked dynamic buffer") {
+    neo::dynbuf_io<neo::chunked_dynamic_buffer> io;
+    std::string                                 expect;
+    std::string                                 got;
+    for (int i = 0; i < 5000; ++i) {
+        auto word = std::to_string(i) + " ";
+        neo::buffer_copy(io, neo::as_buffer(word));
+        expect += word;
+        if (i % 7 == 0) {
+            std::string part(io.available() / 2, '\0');
+            neo::buffer_copy(neo::as_buffer(part), io);
+            got += part;
+        }
+    }
+    std::string rest(io.available(), '\0');
+    neo::buffer_copy(neo::as_buffer(rest), io);
+    got += rest;
+    CHECK(got == expect);
+    // Only the chunks that hold unread data are kept
+    CHECK(io.buffer().chunk_count() <= 1);
+}
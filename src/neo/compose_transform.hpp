@@ -0,0 +1,169 @@
+#pragma once
+
+#include "./buffer_algorithm/transform.hpp"
+#include "./const_buffer.hpp"
+#include "./mutable_buffer.hpp"
+
+#include <neo/fwd.hpp>
+#include <neo/ref_member.hpp>
+
+#include <array>
+#include <cstddef>
+
+namespace neo {
+
+/**
+ * A buffer_transformer that feeds the output of one transformer into another.
+ *
+ * Rather than transforming all of its input with the first stage before
+ * running the second, data is passed between the stages through a small
+ * fixed-size scratch buffer, so each chunk is carried through both stages
+ * while it is still in cache.
+ *
+ * When the first stage declares `done`, the second stage is finished (with
+ * `transform_finish`, if it supports it). When called with an empty input and
+ * `transform_finish`, each stage is finished in turn.
+ */
+template <typename First, typename Second, std::size_t ScratchSize = 1024 * 4>
+class composed_transformer {
+    static_assert(ScratchSize > 0);
+
+    [[no_unique_address]] wrap_ref_member_t<First>  _first;
+    [[no_unique_address]] wrap_ref_member_t<Second> _second;
+
+    std::array<std::byte, ScratchSize> _scratch;
+    std::size_t                        _scratch_pos = 0;
+    std::size_t                        _scratch_end = 0;
+    // Whether the first stage filled the scratch buffer on its last call, and
+    // so may be holding more output
+    bool _first_full  = false;
+    bool _first_done  = false;
+    bool _second_done = false;
+
+    auto _call_first(mutable_buffer out, const_buffer in, bool finishing) {
+        using result_type = simple_transform_result;
+        auto&& tr         = first();
+        if (finishing) {
+            if constexpr (buffer_transformer<decltype(tr), transform_finish_t>) {
+                auto r = tr(out, in, transform_finish);
+                return result_type{r.bytes_written, r.bytes_read, r.done};
+            } else {
+                // The stage may still hold output that did not fit before.
+                // Once it leaves room in the output, it has nothing left.
+                auto r = tr(out, in);
+                return result_type{r.bytes_written,
+                                   r.bytes_read,
+                                   r.done || r.bytes_written < out.size()};
+            }
+        }
+        auto r = tr(out, in);
+        return result_type{r.bytes_written, r.bytes_read, r.done};
+    }
+
+    void _finish_second(mutable_buffer out, simple_transform_result& res) {
+        auto&& tr = second();
+        if constexpr (buffer_transformer<decltype(tr), transform_finish_t>) {
+            auto r = tr(out, const_buffer(), transform_finish);
+            res.bytes_written += r.bytes_written;
+            _second_done = r.done;
+        } else {
+            auto r = tr(out, const_buffer());
+            res.bytes_written += r.bytes_written;
+            _second_done = r.done || r.bytes_written < out.size();
+        }
+        res.done = _second_done;
+    }
+
+    simple_transform_result _run(mutable_buffer out, const_buffer in, bool finishing) {
+        simple_transform_result res;
+        if (_second_done) {
+            res.done = true;
+            return res;
+        }
+        while (true) {
+            if (_scratch_pos != _scratch_end) {
+                auto r = second()(out,
+                                  const_buffer(_scratch.data() + _scratch_pos,
+                                               _scratch_end - _scratch_pos));
+                out += r.bytes_written;
+                res.bytes_written += r.bytes_written;
+                _scratch_pos += r.bytes_read;
+                if (r.done) {
+                    _second_done = true;
+                    res.done     = true;
+                    break;
+                }
+                if (_scratch_pos != _scratch_end) {
+                    // The output is full
+                    break;
+                }
+            }
+            _scratch_pos = 0;
+            _scratch_end = 0;
+
+            if (_first_done) {
+                // Nothing more will come from the first stage
+                _finish_second(out, res);
+                break;
+            }
+            if (in.empty() && !finishing && !_first_full) {
+                break;
+            }
+
+            auto r = _call_first(mutable_buffer(_scratch), in, finishing && in.empty());
+            in += r.bytes_read;
+            res.bytes_read += r.bytes_read;
+            _scratch_end = r.bytes_written;
+            _first_full  = r.bytes_written == ScratchSize;
+            _first_done  = r.done;
+            if (!r.done && r.bytes_read == 0 && r.bytes_written == 0) {
+                break;
+            }
+        }
+        return res;
+    }
+
+public:
+    constexpr composed_transformer() = default;
+    constexpr explicit composed_transformer(First&& f, Second&& s)
+        : _first(NEO_FWD(f))
+        , _second(NEO_FWD(s)) {}
+
+    NEO_DECL_UNREF_GETTER(first, _first);
+    NEO_DECL_UNREF_GETTER(second, _second);
+
+    simple_transform_result operator()(mutable_buffer out, const_buffer in) {
+        return _run(out, in, false);
+    }
+
+    simple_transform_result operator()(mutable_buffer out, const_buffer in, transform_finish_t) {
+        return _run(out, in, in.empty());
+    }
+};
+
+template <typename F, typename S>
+explicit composed_transformer(F&&, S&&) -> composed_transformer<F, S>;
+
+/// Let buffer_transform() hand a composed_transformer a full chunk at a time
+template <typename First, typename Second, std::size_t ScratchSize>
+constexpr std::size_t
+    buffer_transform_dynamic_growth_hint_v<composed_transformer<First, Second, ScratchSize>>
+    = ScratchSize;
+
+/**
+ * Compose two or more buffer_transformers into a single transformer that
+ * passes data through each of them in order. Transformers given as lvalues
+ * are held by reference, so their state may be inspected afterward.
+ */
+template <typename First, typename Second>
+constexpr auto compose_transformers(First&& f, Second&& s) {
+    return composed_transformer<First, Second>(NEO_FWD(f), NEO_FWD(s));
+}
+
+template <typename First, typename Second, typename Third, typename... More>
+constexpr auto compose_transformers(First&& f, Second&& s, Third&& t, More&&... more) {
+    return compose_transformers(NEO_FWD(f),
+                                compose_transformers(NEO_FWD(s), NEO_FWD(t), NEO_FWD(more)...));
+}
+
+}  // namespace neo
@@ -0,0 +1,122 @@
+#include <neo/compose_transform.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/base64.hpp>
+#include <neo/bitwise_transform.hpp>
+#include <neo/checksum.hpp>
+#include <neo/hex.hpp>
+#include <neo/lz4.hpp>
+#include <neo/string_io.hpp>
+#include <neo/test_concept.hpp>
+#include <neo/transform_io.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <string_view>
+
+using namespace std::literals;
+
+NEO_TEST_CONCEPT(
+    neo::buffer_transformer<neo::composed_transformer<neo::hex_encoder, neo::base64_encoder>>);
+NEO_TEST_CONCEPT(
+    neo::buffer_transformer<neo::composed_transformer<neo::hex_encoder, neo::base64_encoder>,
+                            neo::transform_finish_t>);
+
+namespace {
+
+std::string make_input(std::size_t size) {
+    std::string ret;
+    for (std::size_t i = 0; i < size; ++i) {
+        ret.push_back(static_cast<char>(i * 7 + 3));
+    }
+    return ret;
+}
+
+template <typename Transformer>
+std::string transform_all(std::string_view in, Transformer&& tr) {
+    neo::string_dynbuf_io out;
+    neo::buffer_transform(tr, out, neo::as_buffer(in));
+    if constexpr (neo::buffer_transformer<Transformer, neo::transform_finish_t>) {
+        neo::buffer_transform(tr, out, neo::const_buffer(), neo::transform_finish);
+    }
+    return std::string(out.read_area_view());
+}
+
+}  // namespace
+
+TEST_CASE("Compose two transformers") {
+    const auto size  = GENERATE(0u, 1u, 100u, 4096u, 4097u, 50000u);
+    const auto input = make_input(size);
+
+    auto twice = neo::compose_transformers(neo::bitnot_transformer{}, neo::bitnot_transformer{});
+    CHECK(transform_all(input, twice) == input);
+
+    auto round_trip = neo::compose_transformers(neo::hex_encoder{}, neo::hex_decoder{});
+    CHECK(transform_all(input, round_trip) == input);
+
+    auto hex_b64 = neo::compose_transformers(neo::hex_encoder{}, neo::base64_encoder{});
+    CHECK(transform_all(input, hex_b64)
+          == transform_all(transform_all(input, neo::hex_encoder{}), neo::base64_encoder{}));
+}
+
+TEST_CASE("Compose a chain through a sink") {
+    const auto input = make_input(200000);
+
+    neo::xxhash32_transformer checksum;
+    auto                      chain = neo::compose_transformers(checksum,
+                                                           neo::lz4_frame_compressor{},
+                                                           neo::hex_encoder{});
+
+    neo::string_dynbuf_io out;
+    {
+        neo::buffer_transform_sink sink{out, chain};
+        for (std::size_t pos = 0, len = 1; pos < input.size(); pos += len, len += 1013) {
+            neo::buffer_copy(sink, neo::as_buffer(input) + pos, len);
+        }
+        CHECK(sink.finish().done);
+    }
+
+    // The first stage was held by reference
+    neo::xxhash32_digest expect_sum;
+    expect_sum.update(neo::as_buffer(input));
+    CHECK(checksum.digest().digest() == expect_sum.digest());
+
+    // Undo each stage separately
+    auto compressed = transform_all(out.read_area_view(), neo::hex_decoder{});
+    CHECK(transform_all(compressed, neo::lz4_frame_decompressor{}) == input);
+}
+
+TEST_CASE("Composed transformers with tiny output buffers") {
+    const auto input  = make_input(300);
+    auto       chain  = neo::compose_transformers(neo::base64_encoder{}, neo::hex_encoder{});
+    const auto expect = transform_all(input, chain);
+
+    auto              tr     = neo::compose_transformers(neo::base64_encoder{}, neo::hex_encoder{});
+    neo::const_buffer in_buf = neo::as_buffer(input);
+    std::string       out;
+    char              c = 0;
+    while (true) {
+        auto out_buf = neo::mutable_buffer(neo::byte_pointer(&c), 1);
+        auto res     = in_buf.empty() ? tr(out_buf, in_buf, neo::transform_finish)
+                                      : tr(out_buf, in_buf);
+        in_buf += res.bytes_read;
+        out.append(res.bytes_written, c);
+        if (res.done) {
+            break;
+        }
+        REQUIRE(res.bytes_written == 1);
+    }
+    CHECK(out == expect);
+}
+
+TEST_CASE("A finished first stage finishes the composition") {
+    // The decoder stops after the padding, which should flush the encoder
+    auto tr = neo::compose_transformers(neo::base64_decoder{},
+                                        neo::base64_encoder{neo::base64_alphabet::url});
+    neo::string_dynbuf_io out;
+    auto res = neo::buffer_transform(tr, out, neo::as_buffer("Zm8=Zm9v"sv));
+    CHECK(res.done);
+    CHECK(res.bytes_read == 4);
+    CHECK(out.read_area_view() == "Zm8=");
+}
@@ -23,7 +23,9 @@ public:
     using size_type = std::size_t;
 
 private:
-    /// The data contained in the buffer
+    /// The data contained in the buffer.
+    /// NOTE: Do not reorder these members. Buffers are layout-compatible with POSIX `iovec` (See
+    /// neo/iovec.hpp)
     pointer   _data = nullptr;
     size_type _size = 0;
 
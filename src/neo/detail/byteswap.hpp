@@ -0,0 +1,66 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace neo::detail {
+
+template <std::size_t Size>
+struct endian_uint;
+
+// clang-format off
+template <> struct endian_uint<1> { using type = std::uint8_t; };
+template <> struct endian_uint<2> { using type = std::uint16_t; };
+template <> struct endian_uint<4> { using type = std::uint32_t; };
+template <> struct endian_uint<8> { using type = std::uint64_t; };
+// clang-format on
+
+template <typename T>
+using endian_uint_t = typename endian_uint<sizeof(T)>::type;
+
+template <std::unsigned_integral U>
+constexpr U byteswap_uint(U v) noexcept {
+    if constexpr (sizeof(U) == 1) {
+        return v;
+    } else {
+#if defined(__GNUC__) || defined(__clang__)
+        if constexpr (sizeof(U) == 2) {
+            return __builtin_bswap16(v);
+        } else if constexpr (sizeof(U) == 4) {
+            return __builtin_bswap32(v);
+        } else {
+            return __builtin_bswap64(v);
+        }
+#else
+        U ret = 0;
+        for (std::size_t i = 0; i < sizeof(U); ++i) {
+            ret = static_cast<U>((ret << 8) | (v & 0xff));
+            v >>= 8;
+        }
+        return ret;
+#endif
+    }
+}
+
+/**
+ * Reverse the byte order of each `Width`-byte word in `src`, writing the result
+ * to `dest`. `n` must be a multiple of `Width`. `dest` and `src` may be equal,
+ * but must not otherwise overlap.
+ *
+ * This is plain word-at-a-time code, which compilers vectorize well, so that
+ * headers that only need a byteswap do not pull in any intrinsics.
+ */
+template <std::size_t Width>
+void byteswap_words(std::byte* dest, const std::byte* src, std::size_t n) noexcept {
+    using word_type = typename endian_uint<Width>::type;
+    for (; n >= Width; n -= Width, src += Width, dest += Width) {
+        word_type word;
+        std::memcpy(&word, src, Width);
+        word = byteswap_uint(word);
+        std::memcpy(dest, &word, Width);
+    }
+}
+
+}  // namespace neo::detail
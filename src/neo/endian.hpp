@@ -0,0 +1,213 @@
+#pragma once
+
+#include <neo/bit_cast.hpp>
+#include <neo/buffer_algorithm/encode.hpp>
+#include <neo/byte_pointer.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/detail/byteswap.hpp>
+#include <neo/mutable_buffer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+
+namespace neo {
+
+/**
+ * A type that the endian codecs can encode and decode: an 8, 16, 32, or 64-bit
+ * integer, or an IEEE 754 float or double.
+ */
+template <typename T>
+concept endian_codable
+    = (std::integral<T> && !std::same_as<T, bool>
+       && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8))
+    || (std::floating_point<T> && std::numeric_limits<T>::is_iec559
+        && (sizeof(T) == 4 || sizeof(T) == 8));
+
+/**
+ * The result of an endian encoder. The value has been completely written once
+ * `done()`, and otherwise the encoder must be called again with more room and
+ * the same value.
+ */
+struct endian_encode_result {
+    std::size_t bytes_written = 0;
+    bool        complete      = false;
+
+    constexpr bool done() const noexcept { return complete; }
+};
+
+/**
+ * The result of an endian decoder. If the input ended partway through a value,
+ * the decoder holds on to the bytes it has seen, and `has_value()` is not set.
+ */
+template <typename T>
+struct endian_decode_result {
+    std::size_t bytes_read = 0;
+    T           decoded{};
+    bool        complete = false;
+
+    constexpr T&       value() noexcept { return decoded; }
+    constexpr const T& value() const noexcept { return decoded; }
+    constexpr bool     has_value() const noexcept { return complete; }
+    constexpr bool     has_error() const noexcept { return false; }
+};
+
+/**
+ * The result of a `decode_many()` call on an endian decoder.
+ */
+struct endian_decode_many_result {
+    /// The number of bytes of input that were consumed
+    std::size_t bytes_read = 0;
+    /// The number of values that were written to the output
+    std::size_t count = 0;
+};
+
+namespace detail {
+
+/// Write the `Endian` representation of `v` to `out`
+template <std::endian Endian, endian_codable T>
+void endian_store(std::byte* out, T v) noexcept {
+    auto u = neo::bit_cast<endian_uint_t<T>>(v);
+    if constexpr (Endian != std::endian::native) {
+        u = byteswap_uint(u);
+    }
+    std::memcpy(out, &u, sizeof u);
+}
+
+/// Read a `T` from its `Endian` representation at `in`
+template <std::endian Endian, endian_codable T>
+T endian_load(const std::byte* in) noexcept {
+    endian_uint_t<T> u;
+    std::memcpy(&u, in, sizeof u);
+    if constexpr (Endian != std::endian::native) {
+        u = byteswap_uint(u);
+    }
+    return neo::bit_cast<T>(u);
+}
+
+}  // namespace detail
+
+/**
+ * A buffer_encoder that writes each `T` in the given byte order.
+ *
+ * If the output is too small, the encoder remembers how much of the value was
+ * written, and continues from there when called again with the same value.
+ * Encoding a contiguous range with buffer_encode() copies or byteswaps whole
+ * windows of values at once.
+ */
+template <endian_codable T, std::endian Endian>
+class basic_endian_encoder {
+    std::size_t _off = 0;
+
+public:
+    endian_encode_result operator()(mutable_buffer out, T value) noexcept {
+        if (_off == 0 && out.size() >= sizeof(T)) {
+            detail::endian_store<Endian>(out.data(), value);
+            return {sizeof(T), true};
+        }
+        std::array<std::byte, sizeof(T)> tmp;
+        detail::endian_store<Endian>(tmp.data(), value);
+        const auto n = (std::min)(sizeof(T) - _off, out.size());
+        std::memcpy(out.data(), tmp.data() + _off, n);
+        _off += n;
+        if (_off != sizeof(T)) {
+            return {n, false};
+        }
+        _off = 0;
+        return {n, true};
+    }
+};
+
+template <endian_codable T, std::endian Endian>
+struct buffer_encoder_bulk_traits<basic_endian_encoder<T, Endian>> {
+    using value_type               = T;
+    static constexpr bool byteswap = Endian != std::endian::native;
+};
+
+/**
+ * A buffer_decoder that reads each `T` in the given byte order. A value may be
+ * split across any number of calls.
+ */
+template <endian_codable T, std::endian Endian>
+class basic_endian_decoder {
+    std::array<std::byte, sizeof(T)> _partial{};
+    std::size_t                      _have = 0;
+
+public:
+    endian_decode_result<T> operator()(const_buffer in) noexcept {
+        if (_have == 0 && in.size() >= sizeof(T)) {
+            return {sizeof(T), detail::endian_load<Endian, T>(in.data()), true};
+        }
+        const auto n = (std::min)(sizeof(T) - _have, in.size());
+        std::memcpy(_partial.data() + _have, in.data(), n);
+        _have += n;
+        if (_have != sizeof(T)) {
+            return {n, T(), false};
+        }
+        _have = 0;
+        return {n, detail::endian_load<Endian, T>(_partial.data()), true};
+    }
+
+    /**
+     * Decode as many values from `in` as fit in `out`, copying or byteswapping
+     * all whole values at once. A value that is cut off at the end of `in` is
+     * held by the decoder and completed by the next call.
+     */
+    endian_decode_many_result decode_many(const_buffer in, std::span<T> out) noexcept {
+        endian_decode_many_result res;
+        if (out.empty()) {
+            return res;
+        }
+        if (_have != 0) {
+            // Finish the value from a prior call
+            auto one = (*this)(in);
+            in += one.bytes_read;
+            res.bytes_read += one.bytes_read;
+            if (!one.has_value()) {
+                return res;
+            }
+            out[res.count++] = one.value();
+        }
+        const auto n_bulk  = (std::min)(in.size() / sizeof(T), out.size() - res.count);
+        const auto n_bytes = n_bulk * sizeof(T);
+        if constexpr (Endian != std::endian::native && sizeof(T) > 1) {
+            detail::byteswap_words<sizeof(T)>(byte_pointer(out.data() + res.count),
+                                              in.data(),
+                                              n_bytes);
+        } else if (n_bytes != 0) {
+            std::memcpy(out.data() + res.count, in.data(), n_bytes);
+        }
+        in += n_bytes;
+        res.bytes_read += n_bytes;
+        res.count += n_bulk;
+        if (res.count != out.size() && !in.empty()) {
+            // Hold on to the beginning of the next value
+            res.bytes_read += (*this)(in).bytes_read;
+        }
+        return res;
+    }
+};
+
+/// Encode `T` in big-endian (network) byte order
+template <endian_codable T>
+using be_encoder = basic_endian_encoder<T, std::endian::big>;
+
+/// Encode `T` in little-endian byte order
+template <endian_codable T>
+using le_encoder = basic_endian_encoder<T, std::endian::little>;
+
+/// Decode a big-endian (network) byte order `T`
+template <endian_codable T>
+using be_decoder = basic_endian_decoder<T, std::endian::big>;
+
+/// Decode a little-endian byte order `T`
+template <endian_codable T>
+using le_decoder = basic_endian_decoder<T, std::endian::little>;
+
+}  // namespace neo
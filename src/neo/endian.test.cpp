@@ -0,0 +1,157 @@
+#include <neo/endian.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/buffer_algorithm/decode.hpp>
+#include <neo/buffer_algorithm/encode.hpp>
+#include <neo/string_io.hpp>
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+NEO_TEST_CONCEPT(neo::buffer_encoder<neo::be_encoder<std::uint32_t>, std::uint32_t>);
+NEO_TEST_CONCEPT(neo::buffer_encoder<neo::le_encoder<double>, double>);
+NEO_TEST_CONCEPT(neo::buffer_decoder<neo::be_decoder<std::int16_t>>);
+NEO_TEST_CONCEPT(neo::buffer_decoder<neo::le_decoder<float>>);
+
+static_assert(neo::endian_codable<std::int8_t>);
+static_assert(neo::endian_codable<std::uint64_t>);
+static_assert(neo::endian_codable<double>);
+static_assert(!neo::endian_codable<bool>);
+static_assert(neo::buffer_bulk_encoder<neo::be_encoder<std::int64_t>, std::int64_t>);
+static_assert(neo::buffer_bulk_encoder<neo::le_encoder<float>, float>);
+static_assert(!neo::buffer_bulk_encoder<neo::le_encoder<float>, double>);
+
+namespace {
+
+template <typename Encoder, typename T>
+std::string encode_one(T value) {
+    neo::string_dynbuf_io out;
+    auto                  res = neo::buffer_encode(Encoder(), out, value);
+    CHECK(res.done());
+    CHECK(res.bytes_written == sizeof(T));
+    return std::string(out.read_area_view());
+}
+
+template <typename Decoder>
+auto decode_one(std::string_view bytes) {
+    auto res = neo::buffer_decode(Decoder(), neo::as_buffer(bytes));
+    REQUIRE(res.has_value());
+    CHECK(res.bytes_read == bytes.size());
+    return res.value();
+}
+
+}  // namespace
+
+TEST_CASE("Encode and decode fixed-width integers") {
+    CHECK(encode_one<neo::be_encoder<std::uint32_t>>(0x0102'0304u) == "\x01\x02\x03\x04");
+    CHECK(encode_one<neo::le_encoder<std::uint32_t>>(0x0102'0304u) == "\x04\x03\x02\x01");
+    CHECK(encode_one<neo::be_encoder<std::int16_t>>(std::int16_t(-2)) == "\xff\xfe");
+    CHECK(encode_one<neo::le_encoder<std::uint64_t>>(0x0102'0304'0506'0708u)
+          == "\x08\x07\x06\x05\x04\x03\x02\x01");
+    CHECK(encode_one<neo::be_encoder<std::int8_t>>(std::int8_t(-1)) == "\xff");
+
+    CHECK(decode_one<neo::be_decoder<std::uint32_t>>("\x01\x02\x03\x04") == 0x0102'0304u);
+    CHECK(decode_one<neo::le_decoder<std::uint32_t>>("\x01\x02\x03\x04") == 0x0403'0201u);
+    CHECK(decode_one<neo::be_decoder<std::int16_t>>("\xff\xfe") == -2);
+    CHECK(decode_one<neo::be_decoder<std::int64_t>>(std::string("\x80\0\0\0\0\0\0\0", 8))
+          == std::numeric_limits<std::int64_t>::min());
+}
+
+TEST_CASE("Encode and decode IEEE floats") {
+    CHECK(encode_one<neo::be_encoder<float>>(1.0f) == std::string("\x3f\x80\0\0", 4));
+    CHECK(encode_one<neo::le_encoder<float>>(1.0f) == std::string("\0\0\x80\x3f", 4));
+    CHECK(encode_one<neo::be_encoder<double>>(-1.5) == std::string("\xbf\xf8\0\0\0\0\0\0", 8));
+
+    CHECK(decode_one<neo::be_decoder<float>>(std::string("\x3f\x80\0\0", 4)) == 1.0f);
+    CHECK(decode_one<neo::le_decoder<double>>(std::string("\0\0\0\0\0\0\xf8\xbf", 8)) == -1.5);
+    auto inf = decode_one<neo::be_decoder<double>>(std::string("\x7f\xf0\0\0\0\0\0\0", 8));
+    CHECK(inf == std::numeric_limits<double>::infinity());
+}
+
+TEST_CASE("Fixed-width values are resumable across segments") {
+    const double            value = 3.141592653589793;
+    neo::be_encoder<double> enc;
+    std::string             bytes;
+    while (true) {
+        std::byte one{};
+        auto      res = enc(neo::mutable_buffer(&one, 1), value);
+        bytes.push_back(static_cast<char>(one));
+        CHECK(res.bytes_written == 1);
+        if (res.done()) {
+            break;
+        }
+    }
+    CHECK(bytes == encode_one<neo::be_encoder<double>>(value));
+
+    // Feed one byte at a time
+    neo::be_decoder<double> dec;
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        auto res = dec((neo::as_buffer(bytes) + i).first(1));
+        CHECK(res.bytes_read == 1);
+        CHECK(res.has_value() == (i + 1 == bytes.size()));
+        if (res.has_value()) {
+            CHECK(res.value() == value);
+        }
+    }
+}
+
+TEST_CASE("Bulk-encode and batch-decode arrays of fixed-width values") {
+    std::vector<std::uint32_t> values;
+    std::uint32_t              x = 7;
+    for (int i = 0; i < 5000; ++i) {
+        x = x * 1664525u + 1013904223u;
+        values.push_back(x);
+    }
+
+    // The bulk path gives the same bytes as encoding each value on its own
+    neo::string_dynbuf_io out;
+    auto                  res = neo::buffer_encode(neo::be_encoder<std::uint32_t>(), out, values);
+    CHECK(res.done());
+    CHECK(res.bytes_written == values.size() * 4);
+    const auto  bytes = std::string(out.read_area_view());
+    std::string expect(bytes.size(), '\0');
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        neo::be_encoder<std::uint32_t>()(neo::as_buffer(expect) + i * 4, values[i]);
+    }
+    CHECK(bytes == expect);
+
+    // Split at every kind of position, including partway through a value
+    const std::size_t              split = GENERATE(0u, 1u, 6u, 999u, 20000u);
+    neo::be_decoder<std::uint32_t> dec;
+    std::vector<std::uint32_t>     got(values.size());
+    auto                           first = dec.decode_many(neo::as_buffer(bytes, split), got);
+    CHECK(first.bytes_read == split);
+    CHECK(first.count == split / 4);
+    auto second = dec.decode_many(neo::as_buffer(bytes) + split,
+                                  std::span(got).subspan(first.count));
+    CHECK(first.count + second.count == values.size());
+    CHECK(second.bytes_read == bytes.size() - split);
+    CHECK(got == values);
+
+    // Stop when the output is full
+    std::vector<std::uint32_t>     few(10);
+    neo::be_decoder<std::uint32_t> dec2;
+    auto                           part = dec2.decode_many(neo::as_buffer(bytes), few);
+    CHECK(part.count == 10);
+    CHECK(part.bytes_read == 40);
+    CHECK(std::equal(few.begin(), few.end(), values.begin()));
+}
+
+TEST_CASE("Batch-decode little-endian doubles") {
+    std::vector<double>   values = {0.0, -0.5, 1e300, -1e-300, 42.25};
+    neo::string_dynbuf_io out;
+    neo::buffer_encode(neo::le_encoder<double>(), out, values);
+    const auto bytes = std::string(out.read_area_view());
+    CHECK(bytes.size() == values.size() * 8);
+
+    std::vector<double>     got(values.size());
+    neo::le_decoder<double> dec;
+    auto                    res = dec.decode_many(neo::as_buffer(bytes), got);
+    CHECK(res.count == values.size());
+    CHECK(got == values);
+}
@@ -0,0 +1,455 @@
+#pragma once
+
+#include "./async_io.hpp"
+#include "./const_buffer.hpp"
+#include "./mutable_buffer.hpp"
+
+#if __has_include(<sys/epoll.h>)
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#define NEO_BUFFER_HAS_EPOLL 1
+#else
+#define NEO_BUFFER_HAS_EPOLL 0
+#endif
+
+#if NEO_BUFFER_HAS_EPOLL
+
+#include <neo/assert.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <coroutine>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+
+namespace neo {
+
+/**
+ * A minimal single-threaded event loop over Linux epoll. Tasks are given to
+ * `spawn()`, and `run()` drives all of them until they finish, suspending
+ * them while they wait on their file descriptors.
+ *
+ * This is enough to serve many pipes, sockets, and files from one thread with
+ * async_fd_source and async_fd_sink. A file descriptor may have one operation
+ * waiting to read and another waiting to write at the same time, such as a
+ * source and a sink on one socket. It has no timers and is not thread-safe.
+ */
+class epoll_loop {
+public:
+    /**
+     * An operation that is waiting on a file descriptor. `events` is either
+     * `EPOLLIN` or `EPOLLOUT`. When that is ready on `fd`, the loop calls
+     * `try_complete`, and resumes `handle` if it returns `true`. Otherwise the
+     * operation keeps waiting.
+     */
+    struct fd_wait {
+        int                     fd     = -1;
+        std::uint32_t           events = 0;
+        bool                    (*try_complete)(fd_wait&) noexcept = nullptr;
+        std::coroutine_handle<> handle;
+    };
+
+private:
+    // The operations waiting on one file descriptor, which is registered with
+    // epoll for as long as either of them is set
+    struct fd_waiters {
+        fd_wait* reader = nullptr;
+        fd_wait* writer = nullptr;
+
+        std::uint32_t events() const noexcept {
+            return (reader ? std::uint32_t(EPOLLIN) : 0u)
+                | (writer ? std::uint32_t(EPOLLOUT) : 0u);
+        }
+    };
+
+    int                                 _epfd;
+    std::size_t                         _n_waiting = 0;
+    std::unordered_map<int, fd_waiters> _waiters;
+    std::deque<task<void>>              _tasks;
+
+    static void _check(int rc, const char* what) {
+        if (rc < 0) {
+            throw std::system_error(errno, std::system_category(), what);
+        }
+    }
+
+    // Give epoll the events that are wanted on `fd`, or remove it if there are none
+    void _update(int fd, std::uint32_t old_events, std::uint32_t new_events) {
+        if (new_events == old_events) {
+            return;
+        }
+        if (new_events == 0) {
+            _waiters.erase(fd);
+            _check(::epoll_ctl(_epfd, EPOLL_CTL_DEL, fd, nullptr), "epoll_ctl()");
+            return;
+        }
+        ::epoll_event ev{};
+        ev.events  = new_events;
+        ev.data.fd = fd;
+        _check(::epoll_ctl(_epfd, EPOLL_CTL_MOD, fd, &ev), "epoll_ctl()");
+    }
+
+    // Take the operation out of `slot` if it can complete, and return its handle
+    std::coroutine_handle<> _try_complete(fd_wait*& slot) noexcept {
+        if (slot == nullptr || !slot->try_complete(*slot)) {
+            // Not waiting, or a spurious wakeup: Keep waiting
+            return nullptr;
+        }
+        --_n_waiting;
+        return std::exchange(slot, nullptr)->handle;
+    }
+
+    void _poll() {
+        ::epoll_event events[64];
+        const int     n = ::epoll_wait(_epfd, events, 64, -1);
+        if (n < 0 && errno == EINTR) {
+            return;
+        }
+        _check(n, "epoll_wait()");
+        for (int i = 0; i < n; ++i) {
+            // An earlier resumption may have changed the waiters on this fd
+            const auto it = _waiters.find(events[i].data.fd);
+            if (it == _waiters.end()) {
+                continue;
+            }
+            auto&      ws         = it->second;
+            const auto ev         = events[i].events;
+            const auto old_events = ws.events();
+            // Errors and hangups are reported to both directions
+            std::coroutine_handle<> read_h, write_h;
+            if (ev & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+                read_h = _try_complete(ws.reader);
+            }
+            if (ev & (EPOLLOUT | EPOLLERR | EPOLLHUP)) {
+                write_h = _try_complete(ws.writer);
+            }
+            _update(events[i].data.fd, old_events, ws.events());
+            // Resuming may destroy the operations, or wait on this fd again
+            if (read_h) {
+                read_h.resume();
+            }
+            if (write_h) {
+                write_h.resume();
+            }
+        }
+    }
+
+public:
+    epoll_loop()
+        : _epfd(::epoll_create1(EPOLL_CLOEXEC)) {
+        _check(_epfd, "epoll_create1()");
+    }
+
+    epoll_loop(const epoll_loop&) = delete;
+    epoll_loop& operator=(const epoll_loop&) = delete;
+
+    ~epoll_loop() { ::close(_epfd); }
+
+    /// Put a file descriptor in non-blocking mode
+    static void set_nonblocking(int fd) {
+        const int flags = ::fcntl(fd, F_GETFL);
+        _check(flags, "fcntl()");
+        _check(::fcntl(fd, F_SETFL, flags | O_NONBLOCK), "fcntl()");
+    }
+
+    /**
+     * Suspend `w.handle` until `w.fd` is ready. Returns `false` if the file
+     * descriptor cannot be waited upon because it is always ready (as is the
+     * case for regular files), in which case the caller should not suspend.
+     */
+    bool wait(fd_wait& w) {
+        neo_assert(expects,
+                   w.events == EPOLLIN || w.events == EPOLLOUT,
+                   "An epoll_loop operation must wait to either read or write",
+                   w.events);
+        const auto [it, added] = _waiters.try_emplace(w.fd);
+        auto&      ws          = it->second;
+        auto&      slot        = w.events == EPOLLIN ? ws.reader : ws.writer;
+        neo_assert(expects,
+                   slot == nullptr,
+                   "Only one operation may wait in each direction on a file descriptor",
+                   w.fd,
+                   w.events);
+        slot = &w;
+        ::epoll_event ev{};
+        ev.events  = ws.events();
+        ev.data.fd = w.fd;
+        if (::epoll_ctl(_epfd, added ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, w.fd, &ev) != 0) {
+            const int err = errno;
+            slot          = nullptr;
+            if (added) {
+                _waiters.erase(it);
+            }
+            if (err == EPERM) {
+                return false;
+            }
+            throw std::system_error(err, std::system_category(), "epoll_ctl()");
+        }
+        ++_n_waiting;
+        return true;
+    }
+
+    /// Add a task to be run by `run()`. Running tasks may spawn more tasks.
+    void spawn(task<void> t) { _tasks.push_back(std::move(t)); }
+
+    /**
+     * Run every spawned task until all of them are finished. If any of them
+     * failed with an exception, the first such exception is rethrown.
+     */
+    void run() {
+        std::size_t n_started = 0;
+        while (true) {
+            while (n_started < _tasks.size()) {
+                _tasks[n_started++].start();
+            }
+            if (_n_waiting == 0) {
+                break;
+            }
+            _poll();
+        }
+        auto tasks = std::move(_tasks);
+        _tasks.clear();
+        for (auto& t : tasks) {
+            neo_assert(invariant,
+                       t.done(),
+                       "A task in an epoll_loop is waiting on something other than the loop");
+            t.result();
+        }
+    }
+};
+
+/**
+ * An async_buffer_source that reads from a non-blocking file descriptor through
+ * an epoll_loop. Reading a regular file never suspends. `next()` gives an empty
+ * buffer at the end of the input, and throws `std::system_error` if a read
+ * fails.
+ *
+ * The source does not own the file descriptor, and puts it in non-blocking
+ * mode.
+ */
+class async_fd_source {
+    epoll_loop*                  _loop;
+    int                          _fd;
+    std::unique_ptr<std::byte[]> _buf;
+    std::size_t                  _cap;
+    std::size_t                  _pos   = 0;
+    std::size_t                  _avail = 0;
+    bool                         _eof   = false;
+    int                          _error = 0;
+
+    // Returns `false` if reading would block
+    bool _fill() noexcept {
+        if (_avail != 0 || _eof || _error != 0) {
+            return true;
+        }
+        _pos = 0;
+        while (true) {
+            const auto n = ::read(_fd, _buf.get(), _cap);
+            if (n > 0) {
+                _avail = static_cast<std::size_t>(n);
+                return true;
+            } else if (n == 0) {
+                _eof = true;
+                return true;
+            } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return false;
+            } else if (errno != EINTR) {
+                _error = errno;
+                return true;
+            }
+        }
+    }
+
+    class next_op : epoll_loop::fd_wait {
+        async_fd_source& _self;
+        std::size_t      _want;
+
+        static bool _try_complete(fd_wait& w) noexcept {
+            return static_cast<next_op&>(w)._self._fill();
+        }
+
+    public:
+        next_op(async_fd_source& self, std::size_t want) noexcept
+            : fd_wait{self._fd, EPOLLIN, &_try_complete, {}}
+            , _self(self)
+            , _want(want) {}
+
+        bool await_ready() noexcept { return _self._fill(); }
+        bool await_suspend(std::coroutine_handle<> h) {
+            handle = h;
+            return _self._loop->wait(*this);
+        }
+        const_buffer await_resume() {
+            if (_self._error != 0) {
+                throw std::system_error(_self._error, std::system_category(), "read()");
+            }
+            return const_buffer(_self._buf.get() + _self._pos, (std::min)(_want, _self._avail));
+        }
+    };
+
+public:
+    explicit async_fd_source(epoll_loop& loop, int fd, std::size_t buffer_size = 1024 * 64)
+        : _loop(&loop)
+        , _fd(fd)
+        , _buf(new std::byte[buffer_size])
+        , _cap(buffer_size) {
+        epoll_loop::set_nonblocking(fd);
+    }
+
+    int fd() const noexcept { return _fd; }
+
+    next_op next(std::size_t n) noexcept { return next_op(*this, n); }
+
+    void consume(std::size_t n) noexcept {
+        neo_assert(expects,
+                   n <= _avail,
+                   "Cannot consume more bytes than were given by next()",
+                   n,
+                   _avail);
+        _pos += n;
+        _avail -= n;
+    }
+};
+
+/**
+ * An async_buffer_sink that writes to a non-blocking file descriptor through an
+ * epoll_loop. Committed data is held in a buffer, and is written out when
+ * `prepare()` needs more room or when `flush()` is awaited. Writing to a regular
+ * file never suspends. Awaiting either throws `std::system_error` if a write
+ * fails.
+ *
+ * The sink does not own the file descriptor, and puts it in non-blocking mode.
+ * Await `flush()` before closing it.
+ */
+class async_fd_sink {
+    epoll_loop*                  _loop;
+    int                          _fd;
+    std::unique_ptr<std::byte[]> _buf;
+    std::size_t                  _cap;
+    // The committed bytes that are yet to be written
+    std::size_t _begin = 0;
+    std::size_t _end   = 0;
+    int         _error = 0;
+
+    void _write_some() noexcept {
+        while (_begin != _end) {
+            const auto n = ::write(_fd, _buf.get() + _begin, _end - _begin);
+            if (n >= 0) {
+                _begin += static_cast<std::size_t>(n);
+            } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            } else if (errno != EINTR) {
+                _error = errno;
+                return;
+            }
+        }
+        if (_begin == _end) {
+            _begin = _end = 0;
+        } else if (_begin != 0) {
+            std::memmove(_buf.get(), _buf.get() + _begin, _end - _begin);
+            _end -= _begin;
+            _begin = 0;
+        }
+    }
+
+    // Returns `false` if there is no room to write and writing would block
+    bool _make_room(std::size_t want) noexcept {
+        if (_cap - _end < want && _begin != _end) {
+            _write_some();
+        }
+        return want == 0 || _end != _cap || _error != 0;
+    }
+
+    bool _drain() noexcept {
+        _write_some();
+        return _begin == _end || _error != 0;
+    }
+
+    void _throw_if_error() const {
+        if (_error != 0) {
+            throw std::system_error(_error, std::system_category(), "write()");
+        }
+    }
+
+    class prepare_op : epoll_loop::fd_wait {
+        async_fd_sink& _self;
+        std::size_t    _want;
+
+        static bool _try_complete(fd_wait& w) noexcept {
+            auto& op = static_cast<prepare_op&>(w);
+            return op._self._make_room(op._want);
+        }
+
+    public:
+        prepare_op(async_fd_sink& self, std::size_t want) noexcept
+            : fd_wait{self._fd, EPOLLOUT, &_try_complete, {}}
+            , _self(self)
+            , _want(want) {}
+
+        bool await_ready() noexcept { return _self._make_room(_want); }
+        bool await_suspend(std::coroutine_handle<> h) {
+            handle = h;
+            return _self._loop->wait(*this);
+        }
+        mutable_buffer await_resume() {
+            _self._throw_if_error();
+            return mutable_buffer(_self._buf.get() + _self._end,
+                                  (std::min)(_want, _self._cap - _self._end));
+        }
+    };
+
+    class flush_op : epoll_loop::fd_wait {
+        async_fd_sink& _self;
+
+        static bool _try_complete(fd_wait& w) noexcept {
+            return static_cast<flush_op&>(w)._self._drain();
+        }
+
+    public:
+        explicit flush_op(async_fd_sink& self) noexcept
+            : fd_wait{self._fd, EPOLLOUT, &_try_complete, {}}
+            , _self(self) {}
+
+        bool await_ready() noexcept { return _self._drain(); }
+        bool await_suspend(std::coroutine_handle<> h) {
+            handle = h;
+            return _self._loop->wait(*this);
+        }
+        void await_resume() const { _self._throw_if_error(); }
+    };
+
+public:
+    explicit async_fd_sink(epoll_loop& loop, int fd, std::size_t buffer_size = 1024 * 64)
+        : _loop(&loop)
+        , _fd(fd)
+        , _buf(new std::byte[buffer_size])
+        , _cap(buffer_size) {
+        epoll_loop::set_nonblocking(fd);
+    }
+
+    int fd() const noexcept { return _fd; }
+
+    prepare_op prepare(std::size_t n) noexcept { return prepare_op(*this, n); }
+
+    void commit(std::size_t n) noexcept {
+        neo_assert(expects,
+                   n <= _cap - _end,
+                   "Cannot commit more bytes than were given by prepare()",
+                   n,
+                   _cap - _end);
+        _end += n;
+    }
+
+    /// Wait until all committed data has been written
+    flush_op flush() noexcept { return flush_op(*this); }
+};
+
+}  // namespace neo
+
+#endif  // NEO_BUFFER_HAS_EPOLL
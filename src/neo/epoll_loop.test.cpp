@@ -0,0 +1,186 @@
+#include <neo/epoll_loop.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#if NEO_BUFFER_HAS_EPOLL
+
+#include <neo/as_buffer.hpp>
+#include <neo/bitwise_transform.hpp>
+#include <neo/buffer_algorithm/async.hpp>
+#include <neo/string_io.hpp>
+
+#include <sys/socket.h>
+
+#include <csignal>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+NEO_TEST_CONCEPT(neo::async_buffer_source<neo::async_fd_source>);
+NEO_TEST_CONCEPT(neo::async_buffer_sink<neo::async_fd_sink>);
+
+namespace {
+
+struct fd_pipe {
+    int read_end  = -1;
+    int write_end = -1;
+
+    fd_pipe() {
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        read_end  = fds[0];
+        write_end = fds[1];
+    }
+
+    ~fd_pipe() {
+        close_read();
+        close_write();
+    }
+
+    void close_read() {
+        if (read_end >= 0) {
+            ::close(std::exchange(read_end, -1));
+        }
+    }
+
+    void close_write() {
+        if (write_end >= 0) {
+            ::close(std::exchange(write_end, -1));
+        }
+    }
+};
+
+std::string make_data(std::size_t size, char seed) {
+    std::string s;
+    s.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        s.push_back(static_cast<char>(seed + static_cast<char>(i % 53)));
+    }
+    return s;
+}
+
+neo::task<void> send(neo::epoll_loop& loop, fd_pipe& pipe, const std::string& data) {
+    neo::async_fd_sink out{loop, pipe.write_end, 1024 * 4};
+    co_await neo::async_buffer_copy(out, neo::as_buffer(data));
+    co_await out.flush();
+    pipe.close_write();
+}
+
+neo::task<void> receive(neo::epoll_loop& loop, fd_pipe& pipe, std::string& dest) {
+    neo::async_fd_source  in{loop, pipe.read_end};
+    neo::string_dynbuf_io io;
+    co_await neo::async_buffer_copy(io, in);
+    dest = std::string(io.read_area_view());
+}
+
+}  // namespace
+
+TEST_CASE("Stream through a pipe on one thread") {
+    // Larger than a pipe's buffer, so that both ends must wait on each other
+    const auto data = make_data(1024 * 1024, 'a');
+
+    neo::epoll_loop loop;
+    fd_pipe         pipe;
+    std::string     got;
+    loop.spawn(receive(loop, pipe, got));
+    loop.spawn(send(loop, pipe, data));
+    loop.run();
+    CHECK(got == data);
+}
+
+TEST_CASE("Serve many pipes from one thread") {
+    const std::size_t n_streams = 100;
+
+    neo::epoll_loop                      loop;
+    std::vector<std::unique_ptr<fd_pipe>> pipes;
+    std::vector<std::string>              sent(n_streams);
+    std::vector<std::string>              got(n_streams);
+    for (std::size_t i = 0; i < n_streams; ++i) {
+        pipes.push_back(std::make_unique<fd_pipe>());
+        sent[i] = make_data(1024 * 20 + i, static_cast<char>('A' + i % 26));
+        loop.spawn(receive(loop, *pipes[i], got[i]));
+        loop.spawn(send(loop, *pipes[i], sent[i]));
+    }
+    loop.run();
+    CHECK(got == sent);
+}
+
+TEST_CASE("Read and write one socket at the same time") {
+    // Both sides send more than a socket will buffer before either of them reads
+    const auto data_a = make_data(1024 * 1024, 'a');
+    const auto data_b = make_data(1024 * 1024 + 7, 'B');
+
+    int fds[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+    neo::epoll_loop loop;
+    std::string     got_a, got_b;
+    auto            send = [&](int fd, const std::string& data) -> neo::task<void> {
+        neo::async_fd_sink out{loop, fd, 1024 * 4};
+        co_await neo::async_buffer_copy(out, neo::as_buffer(data));
+        co_await out.flush();
+        ::shutdown(fd, SHUT_WR);
+    };
+    auto receive = [&](int fd, std::string& dest) -> neo::task<void> {
+        neo::async_fd_source  in{loop, fd};
+        neo::string_dynbuf_io io;
+        co_await neo::async_buffer_copy(io, in);
+        dest = std::string(io.read_area_view());
+    };
+    loop.spawn(send(fds[0], data_a));
+    loop.spawn(receive(fds[0], got_b));
+    loop.spawn(send(fds[1], data_b));
+    loop.spawn(receive(fds[1], got_a));
+    loop.run();
+    ::close(fds[0]);
+    ::close(fds[1]);
+    CHECK(got_a == data_a);
+    CHECK(got_b == data_b);
+}
+
+TEST_CASE("Transform a file through an async sink and source") {
+    std::unique_ptr<std::FILE, decltype(&std::fclose)> file{std::tmpfile(), &std::fclose};
+    REQUIRE(file);
+    const int fd = ::fileno(file.get());
+
+    const auto      data = make_data(1024 * 200, '0');
+    neo::epoll_loop loop;
+    // The lambdas must outlive their coroutines
+    auto write = [&]() -> neo::task<void> {
+        neo::async_fd_sink out{loop, fd};
+        co_await neo::async_buffer_transform(neo::bitnot_transformer{}, out, neo::as_buffer(data));
+        co_await out.flush();
+    };
+    loop.spawn(write());
+    loop.run();
+
+    REQUIRE(::lseek(fd, 0, SEEK_SET) == 0);
+    neo::string_dynbuf_io io;
+    auto read = [&]() -> neo::task<void> {
+        neo::async_fd_source in{loop, fd};
+        co_await neo::async_buffer_transform(neo::bitnot_transformer{}, io, in);
+    };
+    loop.spawn(read());
+    loop.run();
+    CHECK(io.read_area_view() == data);
+}
+
+TEST_CASE("Errors in tasks are rethrown from run()") {
+    neo::epoll_loop loop;
+    fd_pipe         pipe;
+    pipe.close_read();
+    auto write = [&]() -> neo::task<void> {
+        neo::async_fd_sink out{loop, pipe.write_end};
+        co_await neo::async_buffer_copy(out, neo::as_buffer("data", 4));
+        co_await out.flush();
+    };
+    loop.spawn(write());
+    // Writing to a pipe without a reader fails with EPIPE
+    ::signal(SIGPIPE, SIG_IGN);
+    CHECK_THROWS_AS(loop.run(), std::system_error);
+}
+
+#endif  // NEO_BUFFER_HAS_EPOLL
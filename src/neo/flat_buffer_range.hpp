@@ -0,0 +1,109 @@
+#pragma once
+
+#include <neo/buffer_range.hpp>
+
+#include <neo/assert.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace neo {
+
+/**
+ * A flat_buffer_range is a contiguous table of buffers materialized from another buffer range.
+ * The inner range is walked exactly once, upon construction, and every subsequent iteration is
+ * a plain iteration over an array of buffers.
+ *
+ * Up to `InlineCount` buffers are stored within the object itself. If the inner range has more
+ * buffers than that, the table is moved into a heap allocation.
+ *
+ * Empty buffers in the inner range are dropped from the table. The total size of the range is
+ * recorded while it is built, so `buffer_size` on a flat_buffer_range is constant-time.
+ *
+ * This is useful for complex buffer ranges (e.g. a buffers_seq_concat of several runtime ranges)
+ * that will be iterated many times, as those range iterators may be expensive to advance.
+ */
+template <typename BufferType, std::size_t InlineCount = 16>
+class flat_buffer_range {
+public:
+    using value_type  = BufferType;
+    using buffer_type = value_type;
+
+    using pointer         = buffer_type*;
+    using const_pointer   = const buffer_type*;
+    using reference       = buffer_type&;
+    using const_reference = const buffer_type&;
+    using iterator        = const_pointer;
+    using const_iterator  = const_pointer;
+
+private:
+    buffer_type              _inline[InlineCount == 0 ? 1 : InlineCount];
+    std::vector<buffer_type> _heap;
+    std::size_t              _count     = 0;
+    std::size_t              _byte_size = 0;
+
+    void _push_back(buffer_type b) {
+        if (_heap.empty() && _count < InlineCount) {
+            _inline[_count] = b;
+        } else {
+            if (_heap.empty()) {
+                // Move the inline table into the heap. Reserve double to prevent an immediate
+                // reallocation:
+                _heap.reserve((InlineCount + 1) * 2);
+                _heap.assign(_inline, _inline + _count);
+            }
+            _heap.push_back(b);
+        }
+        ++_count;
+        _byte_size += b.size();
+    }
+
+public:
+    flat_buffer_range() = default;
+
+    /**
+     * Build a flat table of buffers from the given buffer range.
+     */
+    template <buffer_range Range>
+    requires(convertible_to<buffer_range_value_t<Range>, buffer_type>)  //
+        explicit flat_buffer_range(const Range& rng) {
+        for (buffer_type b : rng) {
+            if (!b.empty()) {
+                _push_back(b);
+            }
+        }
+    }
+
+    /// Obtain a pointer to the contiguous array of buffers
+    [[nodiscard]] const_pointer data() const noexcept {
+        return _heap.empty() ? _inline : _heap.data();
+    }
+
+    /// The number of (non-empty) buffers in the table
+    [[nodiscard]] std::size_t size() const noexcept { return _count; }
+    /// Determine whether the table was allocated on the heap
+    [[nodiscard]] bool is_inline() const noexcept { return _heap.empty(); }
+    /// The total number of bytes viewed by the buffers in the table
+    [[nodiscard]] std::size_t buffer_size() const noexcept { return _byte_size; }
+
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return data() + size(); }
+
+    const_reference operator[](std::size_t idx) const noexcept {
+        neo_assert(expects, idx < size(), "Index out-of-range", idx, size());
+        return data()[idx];
+    }
+};
+
+/**
+ * Materialize the given buffer range into a flat_buffer_range. The resulting buffer type is
+ * `mutable_buffer` if the given range is a mutable_buffer_range, otherwise `const_buffer`.
+ */
+template <std::size_t InlineCount = 16, buffer_range Range>
+auto buffers_flatten(const Range& rng) {
+    using buffer_type
+        = std::conditional_t<mutable_buffer_range<Range>, mutable_buffer, const_buffer>;
+    return flat_buffer_range<buffer_type, InlineCount>(rng);
+}
+
+}  // namespace neo
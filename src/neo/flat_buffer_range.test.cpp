@@ -0,0 +1,62 @@
+#include <neo/flat_buffer_range.hpp>
+
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffer_algorithm/count.hpp>
+#include <neo/buffers_cat.hpp>
+#include <neo/static_buffer_vector.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+NEO_TEST_CONCEPT(neo::buffer_range<neo::flat_buffer_range<neo::const_buffer>>);
+NEO_TEST_CONCEPT(neo::mutable_buffer_range<neo::flat_buffer_range<neo::mutable_buffer>>);
+
+TEST_CASE("Flatten a concatenation") {
+    neo::static_buffer_vector<neo::const_buffer, 4> v1;
+    v1.push_back(neo::const_buffer("foo"));
+    v1.push_back(neo::const_buffer(""));
+    v1.push_back(neo::const_buffer("bar"));
+    std::vector<neo::const_buffer> v2 = {neo::const_buffer("baz"), neo::const_buffer("quux")};
+
+    auto cat  = neo::buffers_cat(v1, v2);
+    auto flat = neo::buffers_flatten(cat);
+    CHECK(flat.is_inline());
+    // The empty buffer is dropped
+    CHECK(neo::buffer_count(flat) == 4);
+    CHECK(neo::buffer_size(flat) == 13);
+
+    std::string str;
+    str.resize(13);
+    neo::buffer_copy(neo::as_buffer(str), flat);
+    CHECK(str == "foobarbazquux");
+}
+
+TEST_CASE("Flatten onto the heap") {
+    std::vector<std::string> strings;
+    for (auto i = 0; i < 40; ++i) {
+        strings.push_back(std::to_string(i % 10));
+    }
+    std::vector<neo::mutable_buffer> bufs;
+    for (auto& s : strings) {
+        bufs.push_back(neo::as_buffer(s));
+    }
+
+    auto flat = neo::buffers_flatten<4>(bufs);
+    CHECK_FALSE(flat.is_inline());
+    CHECK(flat.size() == 40);
+    CHECK(neo::buffer_size(flat) == 40);
+
+    neo::buffer_copy(flat, neo::const_buffer("abcdefghijklmnopqrstuvwxyz"));
+    CHECK(strings[0] == "a");
+    CHECK(strings[25] == "z");
+    CHECK(strings[26] == "6");
+
+    // Copies refer to their own table
+    auto copy = flat;
+    CHECK(copy.data() != flat.data());
+    CHECK(neo::buffer_size(copy) == 40);
+}
@@ -0,0 +1,307 @@
+#pragma once
+
+#include <neo/buffer_algorithm/transform.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/mutable_buffer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define NEO_HEX_HAS_AVX2 1
+#endif
+
+namespace neo {
+
+/**
+ * Select the case of the letter digits written by a hex_encoder.
+ */
+enum class hex_case {
+    lower,
+    upper,
+};
+
+namespace detail {
+
+constexpr char hex_digits_lower[] = "0123456789abcdef";
+constexpr char hex_digits_upper[] = "0123456789ABCDEF";
+
+/// Value in the hex decoding table for characters that are not hex digits
+constexpr std::uint8_t hex_invalid = 0xff;
+
+constexpr auto make_hex_decode_table() noexcept {
+    std::array<std::uint8_t, 256> tab{};
+    for (auto& v : tab) {
+        v = hex_invalid;
+    }
+    for (std::uint8_t i = 0; i < 16; ++i) {
+        tab[static_cast<unsigned char>(hex_digits_lower[i])] = i;
+        tab[static_cast<unsigned char>(hex_digits_upper[i])] = i;
+    }
+    return tab;
+}
+
+inline constexpr auto hex_decode_table = make_hex_decode_table();
+
+/**
+ * Encode each of `n` bytes from `in` as two hex digits in `out`.
+ */
+inline void
+hex_encode_bytes(std::byte* out, const std::byte* in, std::size_t n, const char* digits) noexcept {
+#if NEO_HEX_HAS_AVX2
+    if (n >= 32) {
+        const auto lut = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits)));
+        const auto nibble_mask = _mm256_set1_epi8(0x0f);
+        for (; n >= 32; n -= 32, in += 32, out += 64) {
+            const auto v  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+            const auto hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble_mask);
+            const auto lo = _mm256_and_si256(v, nibble_mask);
+            const auto hc = _mm256_shuffle_epi8(lut, hi);
+            const auto lc = _mm256_shuffle_epi8(lut, lo);
+            // Interleave within each lane, then put the lanes back in order
+            const auto a = _mm256_unpacklo_epi8(hc, lc);
+            const auto b = _mm256_unpackhi_epi8(hc, lc);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+                                _mm256_permute2x128_si256(a, b, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 32),
+                                _mm256_permute2x128_si256(a, b, 0x31));
+        }
+    }
+#endif
+    for (; n; --n, ++in, out += 2) {
+        const auto b = std::to_integer<unsigned>(*in);
+        out[0]       = std::byte(digits[b >> 4]);
+        out[1]       = std::byte(digits[b & 0xf]);
+    }
+}
+
+/**
+ * Decode pairs of hex digits from `in` into bytes in `out`. Stops at the first
+ * pair that contains a character that is not a hex digit, and returns the
+ * number of bytes that were decoded.
+ */
+inline std::size_t hex_decode_pairs(std::byte* out, const std::byte* in, std::size_t n) noexcept {
+    const auto n_total = n;
+#if NEO_HEX_HAS_AVX2
+    if (n >= 16) {
+        auto in_range = [](__m256i v, char lo, char hi) {
+            return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(char(lo - 1))),
+                                    _mm256_cmpgt_epi8(_mm256_set1_epi8(char(hi + 1)), v));
+        };
+        for (; n >= 16; n -= 16, in += 32, out += 16) {
+            const auto v     = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+            const auto digit = in_range(v, '0', '9');
+            const auto lower = in_range(v, 'a', 'f');
+            const auto upper = in_range(v, 'A', 'F');
+            const auto valid = _mm256_or_si256(digit, _mm256_or_si256(lower, upper));
+            if (_mm256_movemask_epi8(valid) != -1) {
+                // Let the scalar loop find the bad pair
+                break;
+            }
+            auto delta = _mm256_and_si256(digit, _mm256_set1_epi8(-'0'));
+            delta = _mm256_or_si256(delta, _mm256_and_si256(lower, _mm256_set1_epi8(10 - 'a')));
+            delta = _mm256_or_si256(delta, _mm256_and_si256(upper, _mm256_set1_epi8(10 - 'A')));
+            const auto nibbles = _mm256_add_epi8(v, delta);
+            // Combine each pair of nibbles into a 16-bit (hi * 16 + lo), then
+            // narrow to bytes.
+            const auto words  = _mm256_maddubs_epi16(nibbles, _mm256_set1_epi16(0x0110));
+            const auto packed = _mm256_packus_epi16(words, words);
+            const auto merged = _mm256_permute4x64_epi64(packed, 0b1000);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_castsi256_si128(merged));
+        }
+    }
+#endif
+    for (; n; --n, in += 2, ++out) {
+        const unsigned hi = hex_decode_table[std::to_integer<unsigned char>(in[0])];
+        const unsigned lo = hex_decode_table[std::to_integer<unsigned char>(in[1])];
+        if ((hi | lo) == hex_invalid) {
+            break;
+        }
+        *out = std::byte((hi << 4) | lo);
+    }
+    return n_total - n;
+}
+
+}  // namespace detail
+
+/**
+ * A buffer_transformer that encodes data as pairs of hex digits, optionally
+ * placing a separator character between each pair.
+ *
+ * Output that does not fit in the output buffer is held until more room is
+ * given, so the data may be split at any byte boundary.
+ */
+class hex_encoder {
+    const char*              _digits  = detail::hex_digits_lower;
+    bool                     _has_sep = false;
+    char                     _sep     = 0;
+    bool                     _first   = true;
+    std::array<std::byte, 3> _pending{};
+    std::size_t              _pend_pos = 0;
+    std::size_t              _pend_end = 0;
+
+public:
+    constexpr hex_encoder() = default;
+    constexpr explicit hex_encoder(hex_case c) noexcept
+        : _digits(c == hex_case::upper ? detail::hex_digits_upper : detail::hex_digits_lower) {}
+    constexpr hex_encoder(hex_case c, char separator) noexcept
+        : hex_encoder(c) {
+        _has_sep = true;
+        _sep     = separator;
+    }
+
+    simple_transform_result operator()(mutable_buffer out, const_buffer in) noexcept {
+        simple_transform_result res;
+        while (true) {
+            const auto n_drain = (std::min)(_pend_end - _pend_pos, out.size());
+            std::copy_n(_pending.data() + _pend_pos, n_drain, out.data());
+            _pend_pos += n_drain;
+            out += n_drain;
+            res.bytes_written += n_drain;
+            if (_pend_pos != _pend_end || in.empty()) {
+                break;
+            }
+
+            if (!_has_sep && out.size() >= 2) {
+                // Fast path: Encode as many bytes as will fit
+                const auto n = (std::min)(in.size(), out.size() / 2);
+                detail::hex_encode_bytes(out.data(), in.data(), n, _digits);
+                in += n;
+                out += n * 2;
+                res.bytes_read += n;
+                res.bytes_written += n * 2;
+                continue;
+            }
+
+            if (_has_sep && !_first && out.size() >= 3) {
+                const auto n = (std::min)(in.size(), out.size() / 3);
+                for (std::size_t i = 0; i < n; ++i) {
+                    out[i * 3] = std::byte(_sep);
+                    detail::hex_encode_bytes(out.data() + i * 3 + 1, in.data() + i, 1, _digits);
+                }
+                in += n;
+                out += n * 3;
+                res.bytes_read += n;
+                res.bytes_written += n * 3;
+                continue;
+            }
+
+            // Encode one byte into the pending output
+            _pend_pos = 0;
+            _pend_end = 0;
+            if (_has_sep && !_first) {
+                _pending[_pend_end++] = std::byte(_sep);
+            }
+            detail::hex_encode_bytes(_pending.data() + _pend_end, in.data(), 1, _digits);
+            _pend_end += 2;
+            _first = false;
+            in += 1;
+            res.bytes_read += 1;
+        }
+        return res;
+    }
+};
+
+/**
+ * A buffer_transformer that decodes pairs of hex digits (of either case) into
+ * bytes. If constructed with a separator character, exactly one separator is
+ * expected between each pair.
+ *
+ * If the input contains an unexpected character, the transformer stops before
+ * that character, sets `has_error()`, and declares `done`. When called with an
+ * empty input and `transform_finish`, it declares `done`, and sets
+ * `has_error()` if the input ended partway through a pair.
+ */
+class hex_decoder {
+    enum class state_t : unsigned char {
+        want_hi,
+        want_lo,
+        want_sep,
+        done,
+        error,
+    };
+
+    bool    _has_sep = false;
+    char    _sep     = 0;
+    state_t _state   = state_t::want_hi;
+    // The high nibble of the byte currently being decoded
+    std::uint8_t _hi = 0;
+
+public:
+    constexpr hex_decoder() = default;
+    constexpr explicit hex_decoder(char separator) noexcept
+        : _has_sep(true)
+        , _sep(separator) {}
+
+    /// Whether the decoder has encountered invalid input
+    constexpr bool has_error() const noexcept { return _state == state_t::error; }
+
+    simple_transform_result operator()(mutable_buffer out, const_buffer in) noexcept {
+        simple_transform_result res;
+        while (!in.empty() && _state != state_t::done && _state != state_t::error) {
+            if (_state == state_t::want_hi && !_has_sep && in.size() >= 2 && out.size() >= 1) {
+                // Fast path: Decode as many pairs as will fit
+                const auto n      = (std::min)(in.size() / 2, out.size());
+                const auto n_done = detail::hex_decode_pairs(out.data(), in.data(), n);
+                in += n_done * 2;
+                out += n_done;
+                res.bytes_read += n_done * 2;
+                res.bytes_written += n_done;
+                if (n_done == n) {
+                    continue;
+                }
+                // Fall through to handle the bad pair one character at a time
+            }
+
+            const auto c = std::to_integer<unsigned char>(in[0]);
+            if (_state == state_t::want_sep) {
+                if (c != static_cast<unsigned char>(_sep)) {
+                    _state = state_t::error;
+                    break;
+                }
+                _state = state_t::want_hi;
+            } else {
+                const auto v = detail::hex_decode_table[c];
+                if (v == detail::hex_invalid) {
+                    _state = state_t::error;
+                    break;
+                }
+                if (_state == state_t::want_hi) {
+                    _hi    = v;
+                    _state = state_t::want_lo;
+                } else {
+                    if (out.empty()) {
+                        break;
+                    }
+                    out[0] = std::byte((_hi << 4) | v);
+                    out += 1;
+                    res.bytes_written += 1;
+                    _state = _has_sep ? state_t::want_sep : state_t::want_hi;
+                }
+            }
+            in += 1;
+            res.bytes_read += 1;
+        }
+        res.done = _state == state_t::done || _state == state_t::error;
+        return res;
+    }
+
+    simple_transform_result
+    operator()(mutable_buffer out, const_buffer in, transform_finish_t) noexcept {
+        if (!in.empty()) {
+            return (*this)(out, in);
+        }
+        if (_state == state_t::want_lo) {
+            _state = state_t::error;
+        } else if (_state != state_t::error) {
+            _state = state_t::done;
+        }
+        return {0, 0, true};
+    }
+};
+
+}  // namespace neo
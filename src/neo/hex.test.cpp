@@ -0,0 +1,143 @@
+#include <neo/hex.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/dynbuf_io.hpp>
+#include <neo/string_io.hpp>
+#include <neo/test_concept.hpp>
+#include <neo/transform_io.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+using namespace std::literals;
+
+NEO_TEST_CONCEPT(neo::buffer_transformer<neo::hex_encoder>);
+NEO_TEST_CONCEPT(neo::buffer_transformer<neo::hex_decoder>);
+NEO_TEST_CONCEPT(neo::buffer_transformer<neo::hex_decoder, neo::transform_finish_t>);
+
+namespace {
+
+std::string make_input(std::size_t size) {
+    std::string ret;
+    for (std::size_t i = 0; i < size; ++i) {
+        ret.push_back(static_cast<char>(i * 7 + 3));
+    }
+    return ret;
+}
+
+std::string naive_encode(std::string_view in, const char* fmt, std::string_view sep = "") {
+    std::string ret;
+    for (auto c : in) {
+        if (!ret.empty()) {
+            ret.append(sep);
+        }
+        char buf[3];
+        std::snprintf(buf, sizeof buf, fmt, static_cast<unsigned char>(c));
+        ret.append(buf);
+    }
+    return ret;
+}
+
+template <typename Transformer>
+std::string transform_all(std::string_view in, Transformer&& tr) {
+    neo::string_dynbuf_io out;
+    neo::buffer_transform(tr, out, neo::as_buffer(in));
+    return std::string(out.read_area_view());
+}
+
+}  // namespace
+
+TEST_CASE("Simple hex encoding") {
+    CHECK(transform_all("", neo::hex_encoder{}) == "");
+    CHECK(transform_all("\x01\xab\xff"sv, neo::hex_encoder{}) == "01abff");
+    CHECK(transform_all("\x01\xab\xff"sv, neo::hex_encoder{neo::hex_case::upper}) == "01ABFF");
+    CHECK(transform_all("\x01\xab\xff"sv, neo::hex_encoder{neo::hex_case::lower, ':'})
+          == "01:ab:ff");
+}
+
+TEST_CASE("Simple hex decoding") {
+    CHECK(transform_all("01abFF", neo::hex_decoder{}) == "\x01\xab\xff"sv);
+    CHECK(transform_all("01:ab:FF", neo::hex_decoder{':'}) == "\x01\xab\xff"sv);
+}
+
+TEST_CASE("Encode and decode long data") {
+    const auto size  = GENERATE(15u, 16u, 31u, 32u, 33u, 100u, 1000u, 4097u);
+    const auto input = make_input(size);
+
+    auto encoded = transform_all(input, neo::hex_encoder{});
+    CHECK(encoded == naive_encode(input, "%02x"));
+    CHECK(transform_all(encoded, neo::hex_decoder{}) == input);
+
+    auto upper = transform_all(input, neo::hex_encoder{neo::hex_case::upper});
+    CHECK(upper == naive_encode(input, "%02X"));
+    CHECK(transform_all(upper, neo::hex_decoder{}) == input);
+
+    auto separated = transform_all(input, neo::hex_encoder{neo::hex_case::upper, ' '});
+    CHECK(separated == naive_encode(input, "%02X", " "));
+    CHECK(transform_all(separated, neo::hex_decoder{' '}) == input);
+}
+
+TEST_CASE("Stream hex through a transforming source") {
+    const auto     input = make_input(5000);
+    neo::dynbuf_io in{std::string(input)};
+
+    neo::buffer_transform_source hex_source{in, neo::hex_encoder{neo::hex_case::lower, '-'}};
+    neo::string_dynbuf_io        out;
+    neo::buffer_copy(out, hex_source);
+    CHECK(out.read_area_view() == naive_encode(input, "%02x", "-"));
+}
+
+TEST_CASE("Encode with tiny output buffers") {
+    const auto        input = make_input(50);
+    neo::hex_encoder  enc{neo::hex_case::lower, ','};
+    neo::const_buffer in_buf = neo::as_buffer(input);
+    std::string       out;
+    char              c = 0;
+    while (!in_buf.empty() || out.size() < input.size() * 3 - 1) {
+        auto res = enc(neo::mutable_buffer(neo::byte_pointer(&c), 1), in_buf);
+        CHECK(res.bytes_written == 1);
+        out.push_back(c);
+        in_buf += res.bytes_read;
+    }
+    CHECK(out == naive_encode(input, "%02x", ","));
+}
+
+TEST_CASE("Hex decode errors") {
+    neo::hex_decoder      dec;
+    neo::string_dynbuf_io out;
+    auto                  res = neo::buffer_transform(dec, out, neo::as_buffer("0102x304"sv));
+    CHECK(res.done);
+    CHECK(res.bytes_read == 4);
+    CHECK(dec.has_error());
+    CHECK(out.read_area_view() == "\x01\x02"sv);
+
+    // An error deep within data that is decoded in bulk
+    auto encoded = naive_encode(make_input(300), "%02x");
+    encoded[401] = 'g';
+    neo::hex_decoder dec2;
+    out = {};
+    res = neo::buffer_transform(dec2, out, neo::as_buffer(encoded));
+    CHECK(dec2.has_error());
+    CHECK(res.bytes_read == 401);
+    CHECK(out.read_area_view() == make_input(200));
+
+    // A missing separator
+    neo::hex_decoder dec3{':'};
+    out = {};
+    neo::buffer_transform(dec3, out, neo::as_buffer("01:0203"sv));
+    CHECK(dec3.has_error());
+    CHECK(out.read_area_view() == "\x01\x02"sv);
+
+    // Input that ends partway through a pair
+    neo::hex_decoder dec4;
+    out = {};
+    neo::buffer_transform(dec4, out, neo::as_buffer("010"sv));
+    CHECK_FALSE(dec4.has_error());
+    res = neo::buffer_transform(dec4, out, neo::const_buffer(), neo::transform_finish);
+    CHECK(res.done);
+    CHECK(dec4.has_error());
+}
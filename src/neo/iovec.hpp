@@ -0,0 +1,71 @@
+#pragma once
+
+#include <neo/const_buffer.hpp>
+#include <neo/mutable_buffer.hpp>
+#include <neo/static_buffer_vector.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+#if __has_include(<sys/uio.h>)
+#include <sys/uio.h>
+#define NEO_BUFFER_HAS_IOVEC 1
+#else
+#define NEO_BUFFER_HAS_IOVEC 0
+#endif
+
+#if NEO_BUFFER_HAS_IOVEC
+
+namespace neo {
+
+namespace detail {
+
+template <typename Buffer>
+constexpr bool iovec_layout_compatible_v =     //
+    std::is_standard_layout_v<Buffer>          //
+    && std::is_trivially_copyable_v<Buffer>    //
+    && sizeof(Buffer) == sizeof(::iovec)       //
+    && alignof(Buffer) == alignof(::iovec)     //
+    && offsetof(::iovec, iov_base) == 0        //
+    && offsetof(::iovec, iov_len) == sizeof(typename Buffer::pointer);
+
+}  // namespace detail
+
+/**
+ * Both buffer types store a pointer followed by a size, which is exactly the layout of a POSIX
+ * `iovec`. This permits a contiguous array of buffers to be given directly to `writev`, `readv`,
+ * and `sendmsg`/`recvmsg` without a conversion loop.
+ */
+static_assert(detail::iovec_layout_compatible_v<const_buffer>,
+              "neo::const_buffer is not layout-compatible with iovec on this platform");
+static_assert(detail::iovec_layout_compatible_v<mutable_buffer>,
+              "neo::mutable_buffer is not layout-compatible with iovec on this platform");
+
+/**
+ * Obtain a pointer to an array of `iovec` that aliases the given contiguous array of buffers. The
+ * returned pointer refers to the same storage as `bufs`, and is only valid as long as `bufs` is
+ * valid.
+ *
+ * NOTE: An `iovec` array created from an array of `const_buffer` must only be used for output
+ * operations (e.g. `writev`), as the referred-to memory is read-only.
+ */
+inline const ::iovec* as_iovec_array(const const_buffer* bufs) noexcept {
+    return reinterpret_cast<const ::iovec*>(bufs);
+}
+
+inline const ::iovec* as_iovec_array(const mutable_buffer* bufs) noexcept {
+    return reinterpret_cast<const ::iovec*>(bufs);
+}
+
+/**
+ * Obtain a pointer to an array of `iovec` that aliases the active buffers in the given
+ * static_buffer_vector. The number of elements in the array is `bufs.size()`.
+ */
+template <typename BufferType, std::size_t MaxBuffers>
+const ::iovec* as_iovec_array(const static_buffer_vector<BufferType, MaxBuffers>& bufs) noexcept {
+    return as_iovec_array(bufs.data());
+}
+
+}  // namespace neo
+
+#endif  // NEO_BUFFER_HAS_IOVEC
@@ -0,0 +1,53 @@
+#include <neo/iovec.hpp>
+
+#include <neo/buffers_consumer.hpp>
+
+#include <catch2/catch.hpp>
+
+#if NEO_BUFFER_HAS_IOVEC
+
+#include <string>
+#include <string_view>
+
+#include <unistd.h>
+
+TEST_CASE("Buffers alias iovecs") {
+    std::string str = "I am a string";
+    neo::static_buffer_vector<neo::const_buffer, 4> bufs;
+    bufs.push_back(neo::const_buffer("Hello, "));
+    bufs.push_back(neo::const_buffer(str));
+
+    auto iov = neo::as_iovec_array(bufs);
+    CHECK(iov[0].iov_base == bufs[0].data());
+    CHECK(iov[0].iov_len == 7);
+    CHECK(iov[1].iov_base == str.data());
+    CHECK(iov[1].iov_len == str.size());
+}
+
+TEST_CASE("writev() directly from a buffers_vec_consumer") {
+    auto bufs = {
+        neo::const_buffer("meow"),
+        neo::const_buffer("bark"),
+        neo::const_buffer("sing"),
+    };
+    neo::buffers_vec_consumer cbs{bufs};
+
+    int fds[2] = {};
+    REQUIRE(::pipe(fds) == 0);
+
+    auto part      = cbs.next(10);
+    auto n_written = ::writev(fds[1], neo::as_iovec_array(part), static_cast<int>(part.size()));
+    CHECK(n_written == 10);
+    cbs.consume(static_cast<std::size_t>(n_written));
+
+    std::string str;
+    str.resize(10);
+    CHECK(::read(fds[0], str.data(), str.size()) == 10);
+    CHECK(str == "meowbarksi");
+    CHECK(std::string_view(cbs.next(10)[0]) == "ng");
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+#endif
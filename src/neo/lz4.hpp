@@ -0,0 +1,741 @@
+#pragma once
+
+#include <neo/buffer_algorithm/transform.hpp>
+#include <neo/checksum.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/mutable_buffer.hpp>
+
+#include <neo/assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace neo {
+
+/**
+ * The hash table used by the LZ4 compressor to find matches. The table is
+ * large, so it is kept separate from the compression functions in order that
+ * it can be reused between blocks rather than being reinitialized each time.
+ * Stale entries from prior blocks are harmless: Every candidate match is
+ * verified before it is used.
+ */
+struct lz4_hash_table {
+    static constexpr int hash_bits = 12;
+
+    std::array<std::uint32_t, std::size_t(1) << hash_bits> entries{};
+};
+
+/**
+ * The result of decompressing an LZ4 block.
+ */
+struct lz4_block_result {
+    /// The number of bytes that were written to the output
+    std::size_t bytes_written = 0;
+    /// `true` if the block was malformed or did not fit in the output
+    bool error = false;
+};
+
+/**
+ * The maximum compressed size of an LZ4 block with `n` bytes of input.
+ */
+constexpr std::size_t lz4_compress_bound(std::size_t n) noexcept { return n + n / 255 + 16; }
+
+namespace detail {
+
+/// Every match is at least this long
+constexpr std::size_t lz4_min_match = 4;
+/// The final bytes of a block are always literals
+constexpr std::size_t lz4_last_literals = 5;
+/// The last match must begin at least this far from the end of the block
+constexpr std::size_t lz4_mf_limit     = 12;
+constexpr std::size_t lz4_max_distance = 65535;
+/// Controls how quickly the match search accelerates through incompressible data
+constexpr unsigned lz4_skip_trigger = 6;
+
+inline std::uint32_t lz4_read32(const std::byte* p) noexcept {
+    std::uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+inline std::uint32_t lz4_read_le32(const std::byte* p) noexcept {
+    return std::to_integer<std::uint32_t>(p[0]) | (std::to_integer<std::uint32_t>(p[1]) << 8)
+        | (std::to_integer<std::uint32_t>(p[2]) << 16)
+        | (std::to_integer<std::uint32_t>(p[3]) << 24);
+}
+
+inline void lz4_write_le32(std::byte* p, std::uint32_t v) noexcept {
+    p[0] = std::byte(v & 0xff);
+    p[1] = std::byte((v >> 8) & 0xff);
+    p[2] = std::byte((v >> 16) & 0xff);
+    p[3] = std::byte(v >> 24);
+}
+
+inline std::uint32_t lz4_hash(std::uint32_t seq) noexcept {
+    return (seq * 2654435761u) >> (32 - lz4_hash_table::hash_bits);
+}
+
+/// Count the number of bytes at `ip` and `match` that are equal, stopping at `limit`
+inline std::size_t
+lz4_count_match(const std::byte* ip, const std::byte* match, const std::byte* limit) noexcept {
+    const auto start = ip;
+    while (limit - ip >= 8) {
+        std::uint64_t a, b;
+        std::memcpy(&a, ip, 8);
+        std::memcpy(&b, match, 8);
+        if (const auto diff = a ^ b) {
+            const auto n_bits = std::endian::native == std::endian::little ? std::countr_zero(diff)
+                                                                           : std::countl_zero(diff);
+            return static_cast<std::size_t>(ip - start) + static_cast<std::size_t>(n_bits / 8);
+        }
+        ip += 8;
+        match += 8;
+    }
+    while (ip < limit && *ip == *match) {
+        ++ip;
+        ++match;
+    }
+    return static_cast<std::size_t>(ip - start);
+}
+
+/// Write the extension bytes of a literal or match length that is at least 15
+inline std::byte* lz4_write_length(std::byte* op, std::size_t len) noexcept {
+    for (len -= 15; len >= 255; len -= 255) {
+        *op++ = std::byte(255);
+    }
+    *op++ = std::byte(len);
+    return op;
+}
+
+inline std::byte* lz4_write_literals(std::byte*       op,
+                                     std::byte*       token,
+                                     const std::byte* lit,
+                                     std::size_t      lit_len) noexcept {
+    if (lit_len >= 15) {
+        *token = std::byte(15 << 4);
+        op     = lz4_write_length(op, lit_len);
+    } else {
+        *token = std::byte(lit_len << 4);
+    }
+    std::memcpy(op, lit, lit_len);
+    return op + lit_len;
+}
+
+/**
+ * Compress `n` bytes at `src` as a single LZ4 block into `dst`, which must have
+ * room for `lz4_compress_bound(n)` bytes. Returns the compressed size.
+ */
+inline std::size_t lz4_compress_block_impl(std::byte*       dst,
+                                           const std::byte* src,
+                                           std::size_t      n,
+                                           lz4_hash_table&  table,
+                                           unsigned         acceleration) noexcept {
+    auto&            tab    = table.entries;
+    const std::byte* ip     = src;
+    const std::byte* anchor = src;
+    const std::byte* iend   = src + n;
+    std::byte*       op     = dst;
+
+    // A candidate match is usable if it is behind `ip`, close enough to be
+    // encoded, and actually matches.
+    auto usable = [&](std::uint32_t ref) {
+        const auto pos = static_cast<std::size_t>(ip - src);
+        return ref < pos && pos - ref <= lz4_max_distance
+            && lz4_read32(src + ref) == lz4_read32(ip);
+    };
+
+    if (n >= lz4_mf_limit + 1) {
+        const std::byte* const mflimit_plus_one = iend - lz4_mf_limit + 1;
+        const std::byte* const match_limit      = iend - lz4_last_literals;
+
+        tab[lz4_hash(lz4_read32(ip))] = 0;
+        ++ip;
+        auto fwd_hash = lz4_hash(lz4_read32(ip));
+
+        while (true) {
+            // Search for a match, skipping faster the longer we go without one
+            const std::byte* match;
+            {
+                const std::byte* fwd_ip = ip;
+                unsigned         step   = 1;
+                unsigned         search = acceleration << lz4_skip_trigger;
+                while (true) {
+                    const auto h = fwd_hash;
+                    ip           = fwd_ip;
+                    fwd_ip += step;
+                    step = search++ >> lz4_skip_trigger;
+                    if (fwd_ip > mflimit_plus_one) {
+                        goto last_literals;
+                    }
+                    const auto ref = tab[h];
+                    fwd_hash       = lz4_hash(lz4_read32(fwd_ip));
+                    const bool ok  = usable(ref);
+                    tab[h]         = static_cast<std::uint32_t>(ip - src);
+                    if (ok) {
+                        match = src + ref;
+                        break;
+                    }
+                }
+            }
+
+            // Extend the match backwards
+            while (ip > anchor && match > src && ip[-1] == match[-1]) {
+                --ip;
+                --match;
+            }
+
+            std::byte* token = op++;
+            op = lz4_write_literals(op, token, anchor, static_cast<std::size_t>(ip - anchor));
+
+            while (true) {
+                // Encode the match
+                const auto offset = static_cast<std::size_t>(ip - match);
+                *op++             = std::byte(offset & 0xff);
+                *op++             = std::byte(offset >> 8);
+                const auto match_len
+                    = lz4_count_match(ip + lz4_min_match, match + lz4_min_match, match_limit);
+                ip += lz4_min_match + match_len;
+                if (match_len >= 15) {
+                    *token |= std::byte(15);
+                    op = lz4_write_length(op, match_len);
+                } else {
+                    *token |= std::byte(match_len);
+                }
+                anchor = ip;
+                if (ip >= mflimit_plus_one) {
+                    goto last_literals;
+                }
+
+                tab[lz4_hash(lz4_read32(ip - 2))] = static_cast<std::uint32_t>(ip - 2 - src);
+
+                // Check for an immediate next match, which needs no literals
+                const auto h   = lz4_hash(lz4_read32(ip));
+                const auto ref = tab[h];
+                const bool ok  = usable(ref);
+                tab[h]         = static_cast<std::uint32_t>(ip - src);
+                if (!ok) {
+                    break;
+                }
+                match  = src + ref;
+                token  = op++;
+                *token = std::byte(0);
+            }
+
+            ++ip;
+            fwd_hash = lz4_hash(lz4_read32(ip));
+        }
+    }
+
+last_literals:
+    std::byte* token = op++;
+    op = lz4_write_literals(op, token, anchor, static_cast<std::size_t>(iend - anchor));
+    return static_cast<std::size_t>(op - dst);
+}
+
+/**
+ * Decompress the LZ4 block in [ip, iend) to the output beginning at `op`,
+ * writing no further than `oend`. Matches may refer back as far as
+ * `window_begin`, which allows blocks to refer to the data of prior blocks.
+ */
+inline lz4_block_result lz4_decompress_block_impl(const std::byte* window_begin,
+                                                  std::byte*       op,
+                                                  std::byte*       oend,
+                                                  const std::byte* ip,
+                                                  const std::byte* iend) noexcept {
+    const auto op_begin = op;
+    const auto error    = [&] {
+        return lz4_block_result{static_cast<std::size_t>(op - op_begin), true};
+    };
+
+    auto read_length = [&](std::size_t& len) {
+        while (true) {
+            if (ip == iend) {
+                return false;
+            }
+            const auto b = std::to_integer<std::size_t>(*ip++);
+            len += b;
+            if (b != 255) {
+                return true;
+            }
+        }
+    };
+
+    while (true) {
+        if (ip == iend) {
+            return error();
+        }
+        const auto  token   = std::to_integer<unsigned>(*ip++);
+        std::size_t lit_len = token >> 4;
+        if (lit_len == 15 && !read_length(lit_len)) {
+            return error();
+        }
+        if (static_cast<std::size_t>(iend - ip) < lit_len
+            || static_cast<std::size_t>(oend - op) < lit_len) {
+            return error();
+        }
+        std::memcpy(op, ip, lit_len);
+        op += lit_len;
+        ip += lit_len;
+        if (ip == iend) {
+            // The final sequence has only literals
+            break;
+        }
+
+        if (iend - ip < 2) {
+            return error();
+        }
+        const auto offset = std::to_integer<std::size_t>(ip[0])
+            | (std::to_integer<std::size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<std::size_t>(op - window_begin)) {
+            return error();
+        }
+        std::size_t match_len = token & 0xf;
+        if (match_len == 15 && !read_length(match_len)) {
+            return error();
+        }
+        match_len += lz4_min_match;
+        if (static_cast<std::size_t>(oend - op) < match_len) {
+            return error();
+        }
+        const std::byte* match = op - offset;
+        if (offset >= match_len) {
+            std::memcpy(op, match, match_len);
+            op += match_len;
+        } else {
+            // The match overlaps the output, repeating a short pattern
+            for (auto stop = op + match_len; op != stop; ++op, ++match) {
+                *op = *match;
+            }
+        }
+    }
+    return {static_cast<std::size_t>(op - op_begin), false};
+}
+
+}  // namespace detail
+
+/**
+ * Compress `in` as a single LZ4 block into `out`, which must have room for at
+ * least `lz4_compress_bound(in.size())` bytes. Returns the compressed size.
+ *
+ * Higher `acceleration` values trade compression ratio for speed.
+ */
+inline std::size_t lz4_compress_block(mutable_buffer  out,
+                                      const_buffer    in,
+                                      lz4_hash_table& table,
+                                      unsigned        acceleration = 1) noexcept {
+    neo_assert(expects,
+               out.size() >= lz4_compress_bound(in.size()),
+               "Output buffer for lz4_compress_block() is too small",
+               out.size(),
+               in.size(),
+               lz4_compress_bound(in.size()));
+    neo_assert(expects, acceleration > 0, "LZ4 acceleration must be at least one");
+    return detail::lz4_compress_block_impl(out.data(), in.data(), in.size(), table, acceleration);
+}
+
+/**
+ * Decompress the single LZ4 block `in` into `out`.
+ */
+inline lz4_block_result lz4_decompress_block(mutable_buffer out, const_buffer in) noexcept {
+    return detail::lz4_decompress_block_impl(out.data(),
+                                             out.data(),
+                                             out.data() + out.size(),
+                                             in.data(),
+                                             in.data() + in.size());
+}
+
+/**
+ * A buffer_transformer that compresses data into the LZ4 frame format, with
+ * independent 64 KiB blocks and a content checksum.
+ *
+ * Input is gathered into whole blocks before it is compressed, so call with an
+ * empty input and `transform_finish` to compress the final block and write the
+ * end of the frame.
+ */
+class lz4_frame_compressor {
+public:
+    static constexpr std::size_t block_max_size = 64 * 1024;
+
+private:
+    unsigned               _accel = 1;
+    lz4_hash_table         _table;
+    std::vector<std::byte> _block;
+    std::vector<std::byte> _staged;
+    std::size_t            _staged_pos = 0;
+    xxhash32_digest        _content_hash;
+    bool                   _header_written = false;
+    bool                   _finished       = false;
+
+    std::size_t _drain(mutable_buffer& out) noexcept {
+        const auto n = (std::min)(_staged.size() - _staged_pos, out.size());
+        std::copy_n(_staged.data() + _staged_pos, n, out.data());
+        _staged_pos += n;
+        out += n;
+        return n;
+    }
+
+    void _stage_header() {
+        // Version 01, independent blocks, content checksum; 64 KiB max block size
+        const std::byte descriptor[] = {std::byte(0x64), std::byte(0x40)};
+        xxhash32_digest hc;
+        hc.update(const_buffer(descriptor, sizeof descriptor));
+        const auto pos = _staged.size();
+        _staged.resize(pos + 7);
+        detail::lz4_write_le32(_staged.data() + pos, 0x184d'2204);
+        _staged[pos + 4] = descriptor[0];
+        _staged[pos + 5] = descriptor[1];
+        _staged[pos + 6] = std::byte((hc.digest() >> 8) & 0xff);
+        _header_written  = true;
+    }
+
+    void _stage_block(const std::byte* data, std::size_t n) {
+        const auto pos = _staged.size();
+        _staged.resize(pos + 4 + lz4_compress_bound(n));
+        auto dest      = _staged.data() + pos + 4;
+        auto comp_size = detail::lz4_compress_block_impl(dest, data, n, _table, _accel);
+        if (comp_size >= n) {
+            // Incompressible: Store the block as-is
+            std::memcpy(dest, data, n);
+            detail::lz4_write_le32(_staged.data() + pos,
+                                   static_cast<std::uint32_t>(n) | 0x8000'0000);
+            comp_size = n;
+        } else {
+            detail::lz4_write_le32(_staged.data() + pos, static_cast<std::uint32_t>(comp_size));
+        }
+        _staged.resize(pos + 4 + comp_size);
+    }
+
+public:
+    lz4_frame_compressor() = default;
+    explicit lz4_frame_compressor(unsigned acceleration) noexcept
+        : _accel(acceleration) {
+        neo_assert(expects, acceleration > 0, "LZ4 acceleration must be at least one");
+    }
+
+    simple_transform_result operator()(mutable_buffer out, const_buffer in) {
+        simple_transform_result res;
+        while (true) {
+            res.bytes_written += _drain(out);
+            if (_staged_pos != _staged.size()) {
+                break;
+            }
+            _staged.clear();
+            _staged_pos = 0;
+            if (!_header_written) {
+                _stage_header();
+                continue;
+            }
+            if (in.empty()) {
+                break;
+            }
+            if (_block.empty() && in.size() >= block_max_size) {
+                // Compress a whole block directly from the input
+                _content_hash.update(const_buffer(in.data(), block_max_size));
+                _stage_block(in.data(), block_max_size);
+                in += block_max_size;
+                res.bytes_read += block_max_size;
+                continue;
+            }
+            const auto n_take = (std::min)(block_max_size - _block.size(), in.size());
+            _content_hash.update(const_buffer(in.data(), n_take));
+            _block.insert(_block.end(), in.data(), in.data() + n_take);
+            in += n_take;
+            res.bytes_read += n_take;
+            if (_block.size() == block_max_size) {
+                _stage_block(_block.data(), _block.size());
+                _block.clear();
+            }
+        }
+        return res;
+    }
+
+    simple_transform_result operator()(mutable_buffer out, const_buffer in, transform_finish_t) {
+        if (!in.empty()) {
+            return (*this)(out, in);
+        }
+        if (!_finished) {
+            if (!_header_written) {
+                _stage_header();
+            }
+            if (!_block.empty()) {
+                _stage_block(_block.data(), _block.size());
+                _block.clear();
+            }
+            // The end mark, then the content checksum
+            const auto pos = _staged.size();
+            _staged.resize(pos + 8);
+            detail::lz4_write_le32(_staged.data() + pos, 0);
+            detail::lz4_write_le32(_staged.data() + pos + 4, _content_hash.digest());
+            _finished = true;
+        }
+        simple_transform_result res;
+        res.bytes_written = _drain(out);
+        res.done          = _staged_pos == _staged.size();
+        return res;
+    }
+};
+
+/**
+ * A buffer_transformer that decompresses a single LZ4 frame. Skippable frames
+ * that precede it are ignored. Supports both independent and linked blocks,
+ * and verifies block and content checksums if they are present.
+ *
+ * The transformer declares `done` at the end of the frame. If the data is
+ * malformed or a checksum does not match, it sets `has_error()` and declares
+ * `done`.
+ */
+class lz4_frame_decompressor {
+    enum class state_t : unsigned char {
+        magic,
+        header,
+        skippable_size,
+        skip,
+        block_size,
+        block_data,
+        block_checksum,
+        content_checksum,
+        done,
+        error,
+    };
+
+    state_t                   _state = state_t::magic;
+    std::array<std::byte, 16> _field{};
+    std::size_t               _field_have = 0;
+    std::size_t               _field_need = 4;
+
+    bool        _independent      = true;
+    bool        _block_checksums  = false;
+    bool        _content_checksum = false;
+    std::size_t _block_max        = 0;
+    std::size_t _skip_remaining   = 0;
+
+    std::size_t            _block_size = 0;
+    bool                   _block_raw  = false;
+    std::uint32_t          _block_hash = 0;
+    std::vector<std::byte> _block_in;
+
+    std::vector<std::byte> _window;
+    std::size_t            _out_pos = 0;
+    xxhash32_digest        _content_hash;
+
+    void _expect(state_t st, std::size_t n_bytes) noexcept {
+        _state      = st;
+        _field_have = 0;
+        _field_need = n_bytes;
+    }
+
+    /// Collect bytes of a fixed-size field. Returns `true` once it is complete.
+    bool _collect(const_buffer& in, simple_transform_result& res) noexcept {
+        const auto n = (std::min)(_field_need - _field_have, in.size());
+        std::copy_n(in.data(), n, _field.data() + _field_have);
+        _field_have += n;
+        in += n;
+        res.bytes_read += n;
+        return _field_have == _field_need;
+    }
+
+    std::size_t _drain(mutable_buffer& out) noexcept {
+        const auto n = (std::min)(_window.size() - _out_pos, out.size());
+        std::copy_n(_window.data() + _out_pos, n, out.data());
+        _out_pos += n;
+        out += n;
+        return n;
+    }
+
+    void _parse_header() noexcept {
+        const auto flg = std::to_integer<unsigned>(_field[0]);
+        if (_field_need == 2) {
+            const bool has_content_size = flg & 0x08;
+            const bool has_dict_id      = flg & 0x01;
+            if ((flg >> 6) != 0b01 || has_dict_id) {
+                // Unknown version, or requires a dictionary that we do not have
+                _state = state_t::error;
+                return;
+            }
+            // Collect the rest of the descriptor, and the header checksum
+            _field_need = 2 + (has_content_size ? 8 : 0) + 1;
+            return;
+        }
+        xxhash32_digest hc;
+        hc.update(const_buffer(_field.data(), _field_need - 1));
+        const auto bd_size = (std::to_integer<unsigned>(_field[1]) >> 4) & 0x7;
+        if (std::to_integer<unsigned>(_field[_field_need - 1]) != ((hc.digest() >> 8) & 0xff)
+            || bd_size < 4) {
+            _state = state_t::error;
+            return;
+        }
+        _independent      = flg & 0x20;
+        _block_checksums  = flg & 0x10;
+        _content_checksum = flg & 0x04;
+        _block_max        = std::size_t(1) << (8 + 2 * bd_size);
+        _expect(state_t::block_size, 4);
+    }
+
+    void _decode_block(const std::byte* data) {
+        if (_block_checksums) {
+            xxhash32_digest bh;
+            bh.update(const_buffer(data, _block_size));
+            _block_hash = bh.digest();
+        }
+        // Everything in the window has been drained. Keep only as much history
+        // as later blocks may refer to.
+        if (_independent) {
+            _window.clear();
+        } else if (_window.size() > detail::lz4_max_distance) {
+            _window.erase(_window.begin(),
+                          _window.end() - static_cast<std::ptrdiff_t>(detail::lz4_max_distance));
+        }
+        const auto base = _window.size();
+        _window.resize(base + _block_max);
+        lz4_block_result res;
+        if (_block_raw) {
+            std::memcpy(_window.data() + base, data, _block_size);
+            res.bytes_written = _block_size;
+        } else {
+            res = detail::lz4_decompress_block_impl(_window.data(),
+                                                    _window.data() + base,
+                                                    _window.data() + _window.size(),
+                                                    data,
+                                                    data + _block_size);
+        }
+        _window.resize(base + res.bytes_written);
+        _out_pos = base;
+        if (res.error) {
+            _state = state_t::error;
+            return;
+        }
+        _content_hash.update(const_buffer(_window.data() + base, res.bytes_written));
+        if (_block_checksums) {
+            _expect(state_t::block_checksum, 4);
+        } else {
+            _expect(state_t::block_size, 4);
+        }
+    }
+
+public:
+    /// Whether the decompressor has encountered malformed data
+    constexpr bool has_error() const noexcept { return _state == state_t::error; }
+
+    simple_transform_result operator()(mutable_buffer out, const_buffer in) {
+        simple_transform_result res;
+        while (true) {
+            res.bytes_written += _drain(out);
+            if (_out_pos != _window.size()) {
+                break;
+            }
+            if (_state == state_t::done || _state == state_t::error) {
+                res.done = true;
+                break;
+            }
+            if (in.empty()) {
+                break;
+            }
+
+            switch (_state) {
+            case state_t::magic: {
+                if (!_collect(in, res)) {
+                    break;
+                }
+                const auto magic = detail::lz4_read_le32(_field.data());
+                if (magic == 0x184d'2204) {
+                    _expect(state_t::header, 2);
+                } else if ((magic & 0xffff'fff0) == 0x184d'2a50) {
+                    _expect(state_t::skippable_size, 4);
+                } else {
+                    _state = state_t::error;
+                }
+                break;
+            }
+            case state_t::header:
+                if (_collect(in, res)) {
+                    _parse_header();
+                }
+                break;
+            case state_t::skippable_size:
+                if (_collect(in, res)) {
+                    _skip_remaining = detail::lz4_read_le32(_field.data());
+                    _state          = state_t::skip;
+                }
+                break;
+            case state_t::skip: {
+                const auto n = (std::min)(_skip_remaining, in.size());
+                in += n;
+                res.bytes_read += n;
+                _skip_remaining -= n;
+                if (_skip_remaining == 0) {
+                    _expect(state_t::magic, 4);
+                }
+                break;
+            }
+            case state_t::block_size: {
+                if (!_collect(in, res)) {
+                    break;
+                }
+                const auto v = detail::lz4_read_le32(_field.data());
+                if (v == 0) {
+                    // The end mark
+                    if (_content_checksum) {
+                        _expect(state_t::content_checksum, 4);
+                    } else {
+                        _state = state_t::done;
+                    }
+                    break;
+                }
+                _block_raw  = v & 0x8000'0000;
+                _block_size = v & 0x7fff'ffff;
+                if (_block_size > _block_max) {
+                    _state = state_t::error;
+                    break;
+                }
+                _block_in.clear();
+                _state = state_t::block_data;
+                break;
+            }
+            case state_t::block_data:
+                if (_block_in.empty() && in.size() >= _block_size) {
+                    // Decode directly from the input
+                    const auto data = in.data();
+                    in += _block_size;
+                    res.bytes_read += _block_size;
+                    _decode_block(data);
+                } else {
+                    const auto n = (std::min)(_block_size - _block_in.size(), in.size());
+                    _block_in.insert(_block_in.end(), in.data(), in.data() + n);
+                    in += n;
+                    res.bytes_read += n;
+                    if (_block_in.size() == _block_size) {
+                        _decode_block(_block_in.data());
+                    }
+                }
+                break;
+            case state_t::block_checksum:
+                if (_collect(in, res)) {
+                    if (detail::lz4_read_le32(_field.data()) != _block_hash) {
+                        _state = state_t::error;
+                    } else {
+                        _expect(state_t::block_size, 4);
+                    }
+                }
+                break;
+            case state_t::content_checksum:
+                if (_collect(in, res)) {
+                    const bool ok = detail::lz4_read_le32(_field.data()) == _content_hash.digest();
+                    _state        = ok ? state_t::done : state_t::error;
+                }
+                break;
+            case state_t::done:
+            case state_t::error:
+                break;
+            }
+        }
+        return res;
+    }
+};
+
+}  // namespace neo
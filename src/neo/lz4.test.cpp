@@ -0,0 +1,283 @@
+#include <neo/lz4.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/dynbuf_io.hpp>
+#include <neo/string_io.hpp>
+#include <neo/test_concept.hpp>
+#include <neo/transform_io.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std::literals;
+
+NEO_TEST_CONCEPT(neo::buffer_transformer<neo::lz4_frame_compressor>);
+NEO_TEST_CONCEPT(neo::buffer_transformer<neo::lz4_frame_compressor, neo::transform_finish_t>);
+NEO_TEST_CONCEPT(neo::buffer_transformer<neo::lz4_frame_decompressor>);
+
+namespace {
+
+std::string make_input(std::size_t size) {
+    std::string ret;
+    for (std::size_t i = 0; i < size; ++i) {
+        ret.push_back(static_cast<char>(i * 7 + 3));
+    }
+    return ret;
+}
+
+/// Text with plenty of repetition, but not trivially so
+std::string make_text(std::size_t size) {
+    std::string ret;
+    for (std::size_t i = 0; ret.size() < size; ++i) {
+        ret += "line " + std::to_string(i % 97) + ": the quick brown fox\n";
+    }
+    ret.resize(size);
+    return ret;
+}
+
+std::string bytes_str(std::initializer_list<unsigned> bytes) {
+    std::string ret;
+    for (auto b : bytes) {
+        ret.push_back(static_cast<char>(b));
+    }
+    return ret;
+}
+
+std::string compress_block(std::string_view in, unsigned accel = 1) {
+    neo::lz4_hash_table table;
+    std::string         out(neo::lz4_compress_bound(in.size()), '\0');
+    auto n = neo::lz4_compress_block(neo::as_buffer(out), neo::as_buffer(in), table, accel);
+    out.resize(n);
+    return out;
+}
+
+std::string compress(std::string_view in, neo::lz4_frame_compressor comp = {}) {
+    neo::string_dynbuf_io out;
+    neo::buffer_transform(comp, out, neo::as_buffer(in));
+    neo::buffer_transform(comp, out, neo::const_buffer(), neo::transform_finish);
+    return std::string(out.read_area_view());
+}
+
+std::string decompress(std::string_view in, bool expect_error = false) {
+    neo::lz4_frame_decompressor dec;
+    neo::string_dynbuf_io       out;
+    auto res = neo::buffer_transform(dec, out, neo::as_buffer(in));
+    CHECK(res.done);
+    CHECK(dec.has_error() == expect_error);
+    return std::string(out.read_area_view());
+}
+
+}  // namespace
+
+TEST_CASE("Compress and decompress blocks") {
+    const auto size   = GENERATE(0u, 1u, 12u, 13u, 100u, 4000u, 70000u);
+    const auto accel  = GENERATE(1u, 8u);
+    const auto inputs = {make_input(size), make_text(size), std::string(size, 'z')};
+    for (const auto& input : inputs) {
+        const auto comp = compress_block(input, accel);
+        CHECK(comp.size() <= neo::lz4_compress_bound(input.size()));
+
+        std::string out(input.size(), '\0');
+        auto res = neo::lz4_decompress_block(neo::as_buffer(out), neo::as_buffer(comp));
+        CHECK_FALSE(res.error);
+        CHECK(res.bytes_written == input.size());
+        CHECK(out == input);
+    }
+    if (size >= 4000) {
+        CHECK(compress_block(make_text(size), accel).size() < size / 4);
+    }
+}
+
+TEST_CASE("Reuse a hash table between blocks") {
+    neo::lz4_hash_table table;
+    for (auto size : {5000u, 300u, 20000u}) {
+        const auto  input = size == 300u ? make_input(size) : make_text(size);
+        std::string comp(neo::lz4_compress_bound(size), '\0');
+        comp.resize(
+            neo::lz4_compress_block(neo::as_buffer(comp), neo::as_buffer(input), table));
+        std::string out(size, '\0');
+        auto res = neo::lz4_decompress_block(neo::as_buffer(out), neo::as_buffer(comp));
+        CHECK_FALSE(res.error);
+        CHECK(out == input);
+    }
+}
+
+TEST_CASE("Decompress a hand-built block") {
+    // Three literals, then a match of length 15 at offset 3, then two literals
+    auto        block = bytes_str({0x3b, 'a', 'b', 'c', 0x03, 0x00, 0x20, 'x', 'y'});
+    std::string out(64, '\0');
+    auto res = neo::lz4_decompress_block(neo::as_buffer(out), neo::as_buffer(block));
+    CHECK_FALSE(res.error);
+    out.resize(res.bytes_written);
+    CHECK(out == "abcabcabcabcabcabcxy");
+}
+
+TEST_CASE("Reject malformed blocks") {
+    auto [name, block] = GENERATE(table<std::string_view, std::string>({
+        {"empty", ""},
+        {"zero offset", bytes_str({0x10, 'a', 0x00, 0x00, 0x00})},
+        {"offset too far", bytes_str({0x10, 'a', 0x02, 0x00, 0x00})},
+        {"truncated literals", bytes_str({0x50, 'a', 'b'})},
+        {"truncated offset", bytes_str({0x10, 'a', 0x01})},
+        {"truncated length", bytes_str({0xf0, 0xff})},
+    }));
+    INFO(name);
+    std::string out(64, '\0');
+    CHECK(neo::lz4_decompress_block(neo::as_buffer(out), neo::as_buffer(block)).error);
+
+    // Output that does not fit
+    auto valid = compress_block(make_text(200));
+    out.resize(199);
+    CHECK(neo::lz4_decompress_block(neo::as_buffer(out), neo::as_buffer(valid)).error);
+}
+
+TEST_CASE("An empty frame") {
+    auto frame = compress("");
+    CHECK(frame
+          == bytes_str(
+              {0x04, 0x22, 0x4d, 0x18, 0x64, 0x40, 0xa7, 0, 0, 0, 0, 0x05, 0x5d, 0xcc, 0x02}));
+    CHECK(decompress(frame) == "");
+}
+
+TEST_CASE("Compress and decompress frames") {
+    const auto size  = GENERATE(1u, 100u, 65536u, 65537u, 200000u);
+    const auto accel = GENERATE(1u, 4u);
+    for (const auto& input : {make_input(size), make_text(size)}) {
+        const auto frame = compress(input, neo::lz4_frame_compressor{accel});
+        CHECK(decompress(frame) == input);
+    }
+    if (size >= 65536) {
+        CHECK(compress(make_text(size)).size() < size / 4);
+    }
+}
+
+TEST_CASE("Compress through a sink and decompress through a source") {
+    const auto            input = make_text(150000);
+    neo::string_dynbuf_io compressed;
+    {
+        neo::buffer_transform_sink sink{compressed, neo::lz4_frame_compressor{}};
+        for (std::size_t pos = 0, len = 1; pos < input.size(); pos += len, len += 997) {
+            neo::buffer_copy(sink, neo::as_buffer(input) + pos, len);
+        }
+        auto res = sink.finish();
+        CHECK(res.done);
+    }
+
+    neo::buffer_transform_source source{compressed, neo::lz4_frame_decompressor{}};
+    neo::string_dynbuf_io        out;
+    neo::buffer_copy(out, source);
+    CHECK_FALSE(source.transformer().has_error());
+    CHECK(out.read_area_view() == input);
+}
+
+TEST_CASE("Decompress with tiny buffers") {
+    const auto                  input = make_text(3000);
+    const auto                  frame = compress(input);
+    neo::lz4_frame_decompressor dec;
+    neo::const_buffer           in_buf = neo::as_buffer(frame);
+
+    std::string out;
+    char        c = 0;
+    while (true) {
+        // Give the input one byte at a time, too
+        auto in_one = neo::const_buffer(in_buf.data(), (std::min)(in_buf.size(), std::size_t(1)));
+        auto res    = dec(neo::mutable_buffer(neo::byte_pointer(&c), 1), in_one);
+        in_buf += res.bytes_read;
+        out.append(res.bytes_written, c);
+        if (res.done) {
+            break;
+        }
+        REQUIRE((res.bytes_read != 0 || res.bytes_written != 0));
+    }
+    CHECK_FALSE(dec.has_error());
+    CHECK(in_buf.empty());
+    CHECK(out == input);
+}
+
+TEST_CASE("Decompress linked blocks and skippable frames") {
+    // Version 01, linked blocks, content checksum; 64 KiB blocks
+    std::string descriptor = bytes_str({0x44, 0x40});
+    std::string frame      = bytes_str({0x50, 0x2a, 0x4d, 0x18, 3, 0, 0, 0, 'x', 'x', 'x'});
+    frame += bytes_str({0x04, 0x22, 0x4d, 0x18}) + descriptor;
+    neo::xxhash32_digest hc;
+    hc.update(neo::as_buffer(descriptor));
+    frame.push_back(static_cast<char>((hc.digest() >> 8) & 0xff));
+    // A stored block
+    frame += bytes_str({8, 0, 0, 0x80}) + "abcdefgh";
+    // A block that copies the prior block, then adds five literals
+    frame += bytes_str({9, 0, 0, 0, 0x04, 0x08, 0x00, 0x50}) + "xyzzy";
+    frame += bytes_str({0, 0, 0, 0});
+
+    const auto           expect = "abcdefghabcdefghxyzzy"s;
+    neo::xxhash32_digest content;
+    content.update(neo::as_buffer(expect));
+    const auto sum = content.digest();
+    for (int i = 0; i < 4; ++i) {
+        frame.push_back(static_cast<char>((sum >> (8 * i)) & 0xff));
+    }
+    CHECK(decompress(frame) == expect);
+}
+
+TEST_CASE("Detect corrupted frames") {
+    const auto input = make_text(5000);
+    const auto frame = compress(input);
+
+    // Bad magic number
+    auto bad = frame;
+    bad[0]   = 'x';
+    decompress(bad, true);
+
+    // Bad header checksum
+    bad    = frame;
+    bad[6] = static_cast<char>(bad[6] ^ 1);
+    decompress(bad, true);
+
+    // Corrupt a literal in the block data, which the content checksum catches
+    bad     = frame;
+    auto it = bad.find("quick");
+    REQUIRE(it != bad.npos);
+    bad[it] = 'Q';
+    decompress(bad, true);
+
+    // A block that claims to be larger than the maximum block size
+    bad     = frame;
+    bad[9]  = 0x7f;
+    bad[10] = 0x00;
+    decompress(bad, true);
+}
+
+#if defined(CATCH_CONFIG_ENABLE_BENCHMARKING)
+// Catch2 only provides BENCHMARK when the whole test driver is built with
+// CATCH_CONFIG_ENABLE_BENCHMARKING. Run these with the "[!benchmark]" tag.
+TEST_CASE("LZ4 throughput", "[!benchmark]") {
+    const auto text        = make_text(4 * 1024 * 1024);
+    const auto frame       = compress(text);
+    const auto block_input = std::string_view(text).substr(0, 64 * 1024);
+    const auto block       = compress_block(block_input);
+
+    neo::lz4_hash_table table;
+    std::string         block_out(neo::lz4_compress_bound(block_input.size()), '\0');
+    std::string         plain(block_input.size(), '\0');
+
+    BENCHMARK("Compress a 64 KiB block") {
+        return neo::lz4_compress_block(neo::as_buffer(block_out),
+                                       neo::as_buffer(block_input),
+                                       table);
+    };
+    BENCHMARK("Decompress a 64 KiB block") {
+        return neo::lz4_decompress_block(neo::as_buffer(plain), neo::as_buffer(block))
+            .bytes_written;
+    };
+    BENCHMARK("Compress a 4 MiB frame") { return compress(text).size(); };
+    BENCHMARK("Decompress a 4 MiB frame") {
+        neo::lz4_frame_decompressor dec;
+        neo::string_dynbuf_io       out;
+        neo::buffer_transform(dec, out, neo::as_buffer(frame));
+        return out.available();
+    };
+}
+#endif
@@ -0,0 +1,383 @@
+#pragma once
+
+#include "./buffer_algorithm/copy.hpp"
+#include "./buffer_sink.hpp"
+#include "./const_buffer.hpp"
+#include "./mutable_buffer.hpp"
+#include "./static_buffer_vector.hpp"
+
+#include <neo/assert.hpp>
+#include <neo/fwd.hpp>
+#include <neo/ref_member.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+namespace neo {
+
+/**
+ * Options for an mpsc_aggregating_sink.
+ */
+struct mpsc_sink_options {
+    /// The number of bytes of the shared buffer that producers reserve from
+    std::size_t capacity = 1024 * 1024;
+};
+
+/// The largest number of buffers that an mpsc_aggregating_sink writes at once
+inline constexpr std::size_t mpsc_sink_max_batch = 64;
+
+/// The batch of buffers that an mpsc_aggregating_sink gives to a batch writer
+using mpsc_sink_batch = static_buffer_vector<const_buffer, mpsc_sink_max_batch>;
+
+// clang-format off
+/**
+ * An invocable that writes out a whole batch of buffers at once, such as a
+ * function that calls `writev` with `as_iovec_array(batch)`. It must write all
+ * of the data before returning.
+ */
+template <typename T>
+concept mpsc_sink_batch_writer = std::invocable<T&, const mpsc_sink_batch&>;
+// clang-format on
+
+namespace detail {
+
+/**
+ * The shared storage of an mpsc_aggregating_sink. Producers reserve records
+ * by advancing `_reserved` with a fetch-add, fill them, and then publish them
+ * by storing the record's header. The drain reads records in order of
+ * reservation, stopping at the first that is not yet published.
+ *
+ * Each record starts with an eight-byte header, followed by the data, rounded
+ * up to a multiple of `granule`. Only the data is given to the downstream sink.
+ * The drain zeroes the space of the records that it releases, so that a header
+ * that is not yet published always reads as zero.
+ */
+class mpsc_record_ring {
+public:
+    static constexpr std::size_t granule         = 8;
+    static constexpr std::size_t header_size     = sizeof(std::uint64_t);
+    static constexpr std::size_t cache_line_size = 64;
+
+private:
+    // A header holds the size of its record in the high half, and the number
+    // of bytes of data plus one in the low half. Zero means unpublished.
+    static constexpr std::uint64_t end_mark = 0xffff'ffff;
+
+    // Held as words so that every header is suitably aligned for atomic_ref
+    std::unique_ptr<std::uint64_t[]> _words;
+    std::size_t                      _capacity;
+
+    alignas(cache_line_size) std::atomic<std::size_t> _reserved{0};
+    alignas(cache_line_size) std::atomic<std::size_t> _released{0};
+
+    std::byte* _bytes() const noexcept { return reinterpret_cast<std::byte*>(_words.get()); }
+
+    std::atomic_ref<std::uint64_t> _header_at(std::size_t pos) const noexcept {
+        return std::atomic_ref<std::uint64_t>(_words[(pos & (_capacity - 1)) / granule]);
+    }
+
+    void _wait_for_room(std::size_t end) const noexcept {
+        auto released = _released.load(std::memory_order_acquire);
+        while (end - released > _capacity) {
+            _released.wait(released, std::memory_order_acquire);
+            released = _released.load(std::memory_order_acquire);
+        }
+    }
+
+    void _publish(std::size_t pos, std::size_t size, std::uint64_t low) noexcept {
+        auto hdr = _header_at(pos);
+        hdr.store((std::uint64_t(size) << 32) | low, std::memory_order_release);
+        hdr.notify_one();
+    }
+
+public:
+    explicit mpsc_record_ring(std::size_t min_capacity)
+        : _capacity(std::bit_ceil((std::max)(min_capacity, granule * 4))) {
+        neo_assert(expects,
+                   _capacity <= (std::size_t(1) << 31),
+                   "The capacity of an mpsc_aggregating_sink is too large",
+                   _capacity);
+        _words.reset(new std::uint64_t[_capacity / granule]());
+    }
+
+    std::size_t capacity() const noexcept { return _capacity; }
+
+    /// The largest record that a producer may reserve
+    std::size_t max_record_size() const noexcept { return _capacity / 4; }
+
+    /**
+     * Reserve a record with room for at least `size` bytes of data, waiting for
+     * the drain to make room if needed. Returns the position of the record and
+     * its rounded size, which includes the header.
+     */
+    std::pair<std::size_t, std::size_t> reserve(std::size_t size) noexcept {
+        const auto rec = (size + header_size + granule - 1) & ~(granule - 1);
+        while (true) {
+            const auto pos = _reserved.fetch_add(rec, std::memory_order_relaxed);
+            _wait_for_room(pos + rec);
+            if ((pos & (_capacity - 1)) + rec <= _capacity) {
+                return {pos, rec};
+            }
+            // The record runs off the end of the storage. Skip over it.
+            _publish(pos, rec, 1);
+        }
+    }
+
+    /// The space for data in the record at `pos`
+    mutable_buffer data_at(std::size_t pos, std::size_t size) const noexcept {
+        return mutable_buffer(_bytes() + (pos & (_capacity - 1)) + header_size, size);
+    }
+
+    /// Publish a reserved record that holds `n` bytes of data
+    void publish(std::size_t pos, std::size_t rec, std::size_t n) noexcept {
+        neo_assert(expects,
+                   n + header_size <= rec,
+                   "Committed more bytes to an mpsc_aggregating_sink than were prepared",
+                   n,
+                   rec);
+        _publish(pos, rec, n + 1);
+    }
+
+    /// Publish a record that tells the drain to stop
+    void publish_end() noexcept {
+        auto [pos, rec] = reserve(0);
+        _publish(pos, rec, end_mark);
+    }
+
+    /**
+     * [Drain] Collect the published records that start at `pos` into `batch`,
+     * waiting for the first one if `wait` is true. Returns the position that
+     * follows the collected records, and whether the end record was reached.
+     */
+    std::pair<std::size_t, bool>
+    collect(std::size_t pos, mpsc_sink_batch& batch, bool wait) const noexcept {
+        // Past one full lap, the headers still belong to the records we are collecting
+        const auto stop = pos + _capacity;
+        while (batch.size() < batch.max_size() && pos != stop) {
+            auto hdr = _header_at(pos);
+            auto val = hdr.load(std::memory_order_acquire);
+            if (val == 0) {
+                if (!wait) {
+                    break;
+                }
+                hdr.wait(0, std::memory_order_acquire);
+                continue;
+            }
+            wait           = false;
+            const auto low = val & 0xffff'ffff;
+            if (low == end_mark) {
+                return {pos, true};
+            }
+            if (low > 1) {
+                batch.push_back(const_buffer(data_at(pos, low - 1)));
+            }
+            pos += val >> 32;
+        }
+        return {pos, false};
+    }
+
+    /// [Drain] Hand the space of the records in [from, to) back to the producers
+    void release(std::size_t from, std::size_t to) noexcept {
+        // Records never wrap, but the released range may
+        const auto begin = from & (_capacity - 1);
+        const auto size  = to - from;
+        const auto head  = (std::min)(size, _capacity - begin);
+        std::fill_n(_bytes() + begin, head, std::byte(0));
+        std::fill_n(_bytes(), size - head, std::byte(0));
+        _released.store(to, std::memory_order_release);
+        _released.notify_all();
+    }
+};
+
+}  // namespace detail
+
+/**
+ * A buffer_sink for a single thread that writes into an mpsc_aggregating_sink.
+ * Obtain one from `mpsc_aggregating_sink::producer()` for each thread that
+ * will write.
+ *
+ * Each `prepare()` reserves a record in the shared buffer, which becomes
+ * visible to the drain upon `commit()`. A record is never split, so the bytes of
+ * a single commit are never interleaved with those of other threads. At most
+ * `max_record_size()` bytes are prepared at once. If the shared buffer is full,
+ * `prepare()` waits for the drain to make room.
+ *
+ * The drain cannot pass a record that has been prepared but not committed, so
+ * a thread should commit promptly, and must not hold a prepared record while
+ * preparing with another producer.
+ */
+class mpsc_sink_producer {
+    detail::mpsc_record_ring* _ring;
+
+    std::size_t _pos = 0;
+    std::size_t _rec = 0;
+
+    void _release() noexcept {
+        if (_rec != 0) {
+            _ring->publish(_pos, _rec, 0);
+            _rec = 0;
+        }
+    }
+
+public:
+    explicit mpsc_sink_producer(detail::mpsc_record_ring& r) noexcept
+        : _ring(&r) {}
+
+    mpsc_sink_producer(mpsc_sink_producer&& o) noexcept
+        : _ring(o._ring)
+        , _pos(o._pos)
+        , _rec(std::exchange(o._rec, 0)) {}
+
+    mpsc_sink_producer& operator=(mpsc_sink_producer&& o) noexcept {
+        _release();
+        _ring = o._ring;
+        _pos  = o._pos;
+        _rec  = std::exchange(o._rec, 0);
+        return *this;
+    }
+
+    ~mpsc_sink_producer() { _release(); }
+
+    std::size_t max_record_size() const noexcept { return _ring->max_record_size(); }
+
+    mutable_buffer prepare(std::size_t n) noexcept {
+        n = (std::min)(n, max_record_size());
+        if (n == 0) {
+            return mutable_buffer();
+        }
+        if (_rec < n + detail::mpsc_record_ring::header_size) {
+            // Give back what we reserved before, and reserve something bigger
+            _release();
+            std::tie(_pos, _rec) = _ring->reserve(n);
+        }
+        return _ring->data_at(_pos, n);
+    }
+
+    void commit(std::size_t n) noexcept {
+        if (_rec == 0) {
+            neo_assert(expects,
+                       n == 0,
+                       "Committed to an mpsc_sink_producer without preparing",
+                       n);
+            return;
+        }
+        _ring->publish(_pos, _rec, n);
+        _rec = 0;
+    }
+};
+
+/**
+ * A sink that many threads may write into at once, with the data funneled to a
+ * single downstream sink by a dedicated drain thread.
+ *
+ * Each writing thread obtains its own `producer()`. Producers reserve space in
+ * a shared buffer with a single atomic fetch-add and publish what they write
+ * without waiting on one another. The drain thread collects the published
+ * prefix of the buffer and writes it out in batches of up to
+ * `mpsc_sink_max_batch` buffers. The downstream may be a buffer_sink, or an
+ * mpsc_sink_batch_writer that receives each batch whole (e.g. for `writev`).
+ *
+ * The downstream is used from the drain thread, so it must not be used by
+ * anyone else until `close()` has returned. All producers must be destroyed or
+ * have committed before `close()` is called. If the downstream throws, the rest
+ * of the data is discarded and the exception is rethrown from `close()`.
+ *
+ * If the sink is destroyed without being closed, it is closed upon
+ * destruction, and any exception is discarded.
+ */
+template <typename Sink>
+requires buffer_sink<Sink> || mpsc_sink_batch_writer<Sink>
+class mpsc_aggregating_sink {
+    [[no_unique_address]] wrap_ref_member_t<Sink> _sink;
+
+    detail::mpsc_record_ring _ring;
+    std::exception_ptr       _error;
+    bool                     _closed = false;
+    std::thread              _drain;
+
+    void _write(const mpsc_sink_batch& batch) {
+        if constexpr (mpsc_sink_batch_writer<decltype(sink())>) {
+            sink()(batch);
+        } else {
+            buffer_copy(sink(), batch);
+        }
+    }
+
+    void _run_drain() noexcept {
+        std::size_t pos = 0;
+        while (true) {
+            mpsc_sink_batch batch;
+            auto [next, end] = _ring.collect(pos, batch, true);
+            if (batch.size() != 0 && !_error) {
+                try {
+                    _write(batch);
+                } catch (...) {
+                    _error = std::current_exception();
+                }
+            }
+            _ring.release(pos, next);
+            pos = next;
+            if (end) {
+                break;
+            }
+        }
+    }
+
+public:
+    explicit mpsc_aggregating_sink(Sink&& s, mpsc_sink_options opts = {})
+        : _sink(NEO_FWD(s))
+        , _ring(opts.capacity)
+        , _drain([this] { _run_drain(); }) {}
+
+    mpsc_aggregating_sink(const mpsc_aggregating_sink&) = delete;
+    mpsc_aggregating_sink& operator=(const mpsc_aggregating_sink&) = delete;
+
+    ~mpsc_aggregating_sink() {
+        if (!_closed) {
+            _ring.publish_end();
+            _drain.join();
+        }
+    }
+
+    NEO_DECL_UNREF_GETTER(sink, _sink);
+
+    std::size_t capacity() const noexcept { return _ring.capacity(); }
+
+    /// Obtain a buffer_sink for one thread to write with
+    mpsc_sink_producer producer() noexcept {
+        neo_assert(expects, !_closed, "Obtained a producer from a closed mpsc_aggregating_sink");
+        return mpsc_sink_producer{_ring};
+    }
+
+    /**
+     * Wait for all committed data to be written to the downstream sink and stop
+     * the drain thread. Rethrows any exception thrown by the downstream.
+     */
+    void close() {
+        if (!_closed) {
+            _closed = true;
+            _ring.publish_end();
+            _drain.join();
+        }
+        if (_error) {
+            std::rethrow_exception(std::exchange(_error, nullptr));
+        }
+    }
+};
+
+template <typename S>
+explicit mpsc_aggregating_sink(S&&) -> mpsc_aggregating_sink<S>;
+
+template <typename S>
+explicit mpsc_aggregating_sink(S&&, mpsc_sink_options) -> mpsc_aggregating_sink<S>;
+
+}  // namespace neo
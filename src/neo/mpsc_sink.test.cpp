@@ -0,0 +1,131 @@
+#include <neo/mpsc_sink.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/string_io.hpp>
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+NEO_TEST_CONCEPT(neo::buffer_sink<neo::mpsc_sink_producer>);
+NEO_TEST_CONCEPT(neo::mpsc_sink_batch_writer<void (*)(const neo::mpsc_sink_batch&)>);
+
+TEST_CASE("Write through an mpsc_aggregating_sink from one thread") {
+    neo::string_dynbuf_io      out;
+    neo::mpsc_aggregating_sink sink{out, neo::mpsc_sink_options{64}};
+    CHECK(sink.capacity() == 64);
+    std::string expect;
+    {
+        auto prod = sink.producer();
+        CHECK(prod.max_record_size() == 16);
+        for (int i = 0; i < 100; ++i) {
+            auto line = "line " + std::to_string(i) + "\n";
+            CHECK(neo::buffer_copy(prod, neo::as_buffer(line)) == line.size());
+            expect += line;
+        }
+        // Preparing without committing writes nothing
+        prod.prepare(10);
+    }
+    sink.close();
+    CHECK(out.read_area_view() == expect);
+}
+
+TEST_CASE("Records of every size reuse the space of earlier records") {
+    neo::string_dynbuf_io      out;
+    neo::mpsc_aggregating_sink sink{out, neo::mpsc_sink_options{64}};
+    std::string                expect;
+    {
+        auto prod = sink.producer();
+        // Data of all-ones bytes would look like a published header if it were left behind
+        for (std::size_t i = 0; i < 500; ++i) {
+            std::string rec(i % 17, char(0xff));
+            rec += char('a' + i % 26);
+            neo::buffer_copy(prod, neo::as_buffer(rec));
+            expect += rec;
+        }
+    }
+    sink.close();
+    CHECK(out.read_area_view() == expect);
+}
+
+TEST_CASE("Many threads write through an mpsc_aggregating_sink") {
+    const auto capacity  = GENERATE(256u, 1024u * 1024u);
+    const int  n_threads = 8;
+    const int  n_lines   = 2000;
+
+    neo::string_dynbuf_io      out;
+    neo::mpsc_aggregating_sink sink{out, neo::mpsc_sink_options{capacity}};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < n_threads; ++t) {
+        threads.emplace_back([&, t] {
+            auto prod = sink.producer();
+            for (int i = 0; i < n_lines; ++i) {
+                auto line = std::to_string(t) + " " + std::to_string(i) + "\n";
+                neo::buffer_copy(prod, neo::as_buffer(line));
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    sink.close();
+
+    // Every line arrives whole, and each thread's lines arrive in order
+    std::map<int, int> next_line;
+    std::istringstream lines{std::string(out.read_area_view())};
+    int                t = 0, i = 0, count = 0;
+    while (lines >> t >> i) {
+        CHECK(i == next_line[t]);
+        next_line[t] = i + 1;
+        ++count;
+    }
+    CHECK(count == n_threads * n_lines);
+}
+
+TEST_CASE("Drain an mpsc_aggregating_sink to a batch writer") {
+    std::string data;
+    std::size_t n_batches = 0;
+    auto        writer    = [&](const neo::mpsc_sink_batch& batch) {
+        ++n_batches;
+        for (auto buf : batch) {
+            data.append(reinterpret_cast<const char*>(buf.data()), buf.size());
+        }
+    };
+
+    std::string expect;
+    {
+        neo::mpsc_aggregating_sink sink{writer};
+        auto                       prod = sink.producer();
+        for (int i = 0; i < 1000; ++i) {
+            auto word = std::to_string(i) + ",";
+            neo::buffer_copy(prod, neo::as_buffer(word));
+            expect += word;
+        }
+    }
+    CHECK(data == expect);
+    CHECK(n_batches > 0);
+    CHECK(n_batches <= 1000);
+}
+
+TEST_CASE("Errors from the downstream are rethrown by close()") {
+    auto writer = [](const neo::mpsc_sink_batch&) { throw std::runtime_error("disk full"); };
+
+    neo::mpsc_aggregating_sink sink{writer, neo::mpsc_sink_options{64}};
+    {
+        auto prod = sink.producer();
+        // The drain keeps making room after the failure
+        for (int i = 0; i < 100; ++i) {
+            neo::buffer_copy(prod, neo::as_buffer("some data", 9));
+        }
+    }
+    CHECK_THROWS_AS(sink.close(), std::runtime_error);
+    CHECK_NOTHROW(sink.close());
+}
@@ -0,0 +1,284 @@
+#pragma once
+
+#include "./as_buffer.hpp"
+#include "./buffer_algorithm/copy.hpp"
+#include "./buffer_algorithm/transform.hpp"
+#include "./buffer_sink.hpp"
+#include "./string_io.hpp"
+
+#include <neo/assert.hpp>
+#include <neo/fwd.hpp>
+#include <neo/ref_member.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace neo {
+
+namespace detail {
+
+/**
+ * A pool of worker threads that each transform whole blocks with a fresh copy
+ * of a prototype transformer. Results are collected in submission order.
+ */
+template <typename Transform>
+class parallel_block_pool {
+    struct job {
+        std::size_t seq;
+        std::string input;
+    };
+
+    struct slot {
+        std::string        output;
+        std::string        input;
+        std::exception_ptr error;
+        bool               ready = false;
+    };
+
+    const Transform          _proto;
+    std::mutex               _mtx;
+    std::condition_variable  _work_cv;
+    std::condition_variable  _done_cv;
+    std::deque<job>          _jobs;
+    std::deque<slot>         _slots;
+    std::size_t              _front_seq = 0;
+    std::size_t              _next_seq  = 0;
+    bool                     _stopping  = false;
+    std::vector<std::thread> _threads;
+    // Input blocks that have been written out, for reuse by the submitter. Only
+    // touched by the thread that calls write_results() and take_spare_block().
+    std::vector<std::string> _spare_blocks;
+
+    static std::string _run(Transform tr, const std::string& in) {
+        string_dynbuf_io out;
+        buffer_transform(tr, out, as_buffer(in));
+        if constexpr (buffer_transformer<Transform, transform_finish_t>) {
+            buffer_transform(tr, out, const_buffer(), transform_finish);
+        }
+        const auto n   = out.available();
+        auto       ret = std::move(out).string();
+        ret.resize(n);
+        return ret;
+    }
+
+    void _work() {
+        std::unique_lock lk{_mtx};
+        while (true) {
+            _work_cv.wait(lk, [&] { return _stopping || !_jobs.empty(); });
+            if (_stopping) {
+                return;
+            }
+            auto j = std::move(_jobs.front());
+            _jobs.pop_front();
+            lk.unlock();
+
+            slot result;
+            try {
+                result.output = _run(_proto, j.input);
+            } catch (...) {
+                result.error = std::current_exception();
+            }
+            result.input = std::move(j.input);
+            result.ready = true;
+
+            lk.lock();
+            _slots[j.seq - _front_seq] = std::move(result);
+            _done_cv.notify_all();
+        }
+    }
+
+public:
+    parallel_block_pool(Transform tr, std::size_t n_threads)
+        : _proto(std::move(tr)) {
+        _threads.reserve(n_threads);
+        for (std::size_t i = 0; i < n_threads; ++i) {
+            _threads.emplace_back([this] { _work(); });
+        }
+    }
+
+    ~parallel_block_pool() {
+        {
+            std::lock_guard lk{_mtx};
+            _stopping = true;
+        }
+        _work_cv.notify_all();
+        for (auto& t : _threads) {
+            t.join();
+        }
+    }
+
+    std::size_t thread_count() const noexcept { return _threads.size(); }
+
+    /**
+     * Obtain an input block that has already been transformed and written, to
+     * be refilled and submitted again, or an empty string if there is none.
+     */
+    std::string take_spare_block() noexcept {
+        if (_spare_blocks.empty()) {
+            return std::string();
+        }
+        auto ret = std::move(_spare_blocks.back());
+        _spare_blocks.pop_back();
+        return ret;
+    }
+
+    void submit(std::string block) {
+        {
+            std::lock_guard lk{_mtx};
+            _jobs.push_back({_next_seq++, std::move(block)});
+            _slots.emplace_back();
+        }
+        _work_cv.notify_one();
+    }
+
+    /**
+     * Write the results of finished blocks to `sink` in order. Waits for
+     * blocks to finish until no more than `max_pending` remain outstanding.
+     * If the transformation of a block threw an exception, it is rethrown.
+     */
+    template <typename Sink>
+    void write_results(Sink& sink, std::size_t max_pending) {
+        std::unique_lock lk{_mtx};
+        while (!_slots.empty()) {
+            if (!_slots.front().ready) {
+                if (_slots.size() <= max_pending) {
+                    break;
+                }
+                _done_cv.wait(lk, [&] { return _slots.front().ready; });
+            }
+            auto s = std::move(_slots.front());
+            _slots.pop_front();
+            ++_front_seq;
+            lk.unlock();
+            _spare_blocks.push_back(std::move(s.input));
+            if (s.error) {
+                std::rethrow_exception(s.error);
+            }
+            buffer_copy(sink, as_buffer(s.output));
+            lk.lock();
+        }
+    }
+};
+
+}  // namespace detail
+
+/**
+ * A buffer_sink that splits the data committed to it into independent blocks
+ * of `block_size` bytes, transforms each block on a pool of worker threads,
+ * and writes the transformed blocks to the underlying sink in their original
+ * order.
+ *
+ * Each block is transformed by a new copy of the given transformer, which is
+ * finished with `transform_finish` if it supports it. The output is the
+ * concatenation of the transformed blocks, so the transformation should be one
+ * for which that is meaningful, such as compression into self-contained
+ * frames.
+ *
+ * Call `finish()` to transform the final partial block and wait for all
+ * outstanding blocks to be written. Data that is not finished when the sink is
+ * destroyed is discarded.
+ *
+ * Finished blocks are also written by `commit()`, so an exception from the
+ * transformation of a block is rethrown by whichever `commit()` or `finish()`
+ * reaches it, once the blocks before it have been written.
+ */
+template <buffer_sink Sink, buffer_transformer Transform>
+class parallel_block_transform_sink {
+    using pool_type = detail::parallel_block_pool<std::remove_cvref_t<Transform>>;
+
+    [[no_unique_address]] wrap_ref_member_t<Sink> _sink;
+
+    std::size_t                _block_size;
+    std::size_t                _max_pending;
+    std::string                _block;
+    std::size_t                _block_used = 0;
+    std::unique_ptr<pool_type> _pool;
+
+    // Start a new block, reusing one that has been written out where possible
+    // so that only the first few blocks are allocated and zero-filled.
+    void _submit_block() {
+        auto next = _pool->take_spare_block();
+        next.resize(_block_size);
+        _pool->submit(std::exchange(_block, std::move(next)));
+        _block_used = 0;
+    }
+
+public:
+    /**
+     * Create a sink that writes to `s`, transforming blocks of `block_size`
+     * bytes with copies of `tr` on `n_threads` threads. If `n_threads` is zero,
+     * one thread per hardware thread is used. The transformer is always held
+     * by value, as the worker threads must not share it.
+     */
+    explicit parallel_block_transform_sink(Sink&&      s,
+                                           Transform&& tr,
+                                           std::size_t block_size,
+                                           std::size_t n_threads = 0)
+        : _sink(NEO_FWD(s))
+        , _block_size(block_size)
+        , _block(block_size, '\0') {
+        neo_assert(expects,
+                   block_size != 0,
+                   "parallel_block_transform_sink requires a non-zero block size");
+        if (n_threads == 0) {
+            n_threads = (std::max)(std::thread::hardware_concurrency(), 1u);
+        }
+        // Allow enough blocks in flight to keep every worker busy while the
+        // results at the front are waiting to be written.
+        _max_pending = n_threads * 2;
+        _pool        = std::make_unique<pool_type>(NEO_FWD(tr), n_threads);
+    }
+
+    NEO_DECL_UNREF_GETTER(sink, _sink);
+
+    std::size_t block_size() const noexcept { return _block_size; }
+    std::size_t thread_count() const noexcept { return _pool->thread_count(); }
+
+    mutable_buffer prepare(std::size_t size) noexcept {
+        return as_buffer(as_buffer(_block) + _block_used, size);
+    }
+
+    void commit(std::size_t n) {
+        neo_assert(expects,
+                   n <= _block_size - _block_used,
+                   "Committed more bytes to a parallel_block_transform_sink than were prepared",
+                   n,
+                   _block_size - _block_used);
+        _block_used += n;
+        if (_block_used == _block_size) {
+            _submit_block();
+        }
+        _pool->write_results(sink(), _max_pending);
+    }
+
+    /**
+     * Transform the final partial block, and wait until every block has been
+     * written to the underlying sink.
+     */
+    void finish() {
+        if (_block_used != 0) {
+            _block.resize(_block_used);
+            _submit_block();
+        }
+        _pool->write_results(sink(), 0);
+    }
+};
+
+template <typename S, typename Tr>
+explicit parallel_block_transform_sink(S&&, Tr&&, std::size_t)
+    -> parallel_block_transform_sink<S, Tr>;
+
+template <typename S, typename Tr>
+explicit parallel_block_transform_sink(S&&, Tr&&, std::size_t, std::size_t)
+    -> parallel_block_transform_sink<S, Tr>;
+
+}  // namespace neo
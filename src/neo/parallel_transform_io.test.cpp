@@ -0,0 +1,117 @@
+#include <neo/parallel_transform_io.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/bitwise_transform.hpp>
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/hex.hpp>
+#include <neo/lz4.hpp>
+#include <neo/string_io.hpp>
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+NEO_TEST_CONCEPT(
+    neo::buffer_sink<neo::parallel_block_transform_sink<neo::string_dynbuf_io&, neo::hex_encoder>>);
+
+namespace {
+
+std::string make_input(std::size_t size) {
+    std::string ret;
+    for (std::size_t i = 0; i < size; ++i) {
+        ret.push_back(static_cast<char>(i * 7 + 3));
+    }
+    return ret;
+}
+
+std::string hex(std::string_view in) {
+    neo::string_dynbuf_io out;
+    neo::hex_encoder      enc;
+    neo::buffer_transform(enc, out, neo::as_buffer(in));
+    return std::string(out.read_area_view());
+}
+
+/// Fails on any block that begins with an 'x'
+struct throwing_transformer {
+    neo::simple_transform_result operator()(neo::mutable_buffer out, neo::const_buffer in) const {
+        if (!in.empty() && in[0] == std::byte('x')) {
+            throw std::runtime_error("bad block");
+        }
+        auto n = neo::buffer_copy(out, in);
+        return {n, n, false};
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Transform blocks in parallel, in order") {
+    const auto size       = GENERATE(0u, 1u, 1000u, 1024u, 100000u);
+    const auto block_size = GENERATE(1u, 7u, 1024u, 4096u);
+    const auto n_threads  = GENERATE(1u, 4u);
+    const auto input      = make_input(size);
+
+    neo::string_dynbuf_io               out;
+    neo::parallel_block_transform_sink sink{out, neo::hex_encoder{}, block_size, n_threads};
+    CHECK(sink.thread_count() == n_threads);
+    CHECK(sink.block_size() == block_size);
+    for (std::size_t pos = 0, len = 1; pos < input.size(); pos += len, len += 333) {
+        neo::buffer_copy(sink, neo::as_buffer(input) + pos, len);
+    }
+    sink.finish();
+    CHECK(out.read_area_view() == hex(input));
+}
+
+TEST_CASE("Compress independent LZ4 frames in parallel") {
+    std::string input;
+    for (int i = 0; input.size() < 300000; ++i) {
+        input += "record " + std::to_string(i % 1000) + "\n";
+    }
+
+    neo::string_dynbuf_io compressed;
+    {
+        neo::parallel_block_transform_sink sink{compressed, neo::lz4_frame_compressor{}, 65536};
+        neo::buffer_copy(sink, neo::as_buffer(input));
+        sink.finish();
+    }
+    CHECK(compressed.available() < input.size() / 2);
+
+    // Each block was compressed as its own frame
+    neo::const_buffer     frames = neo::as_buffer(compressed.read_area_view());
+    neo::string_dynbuf_io out;
+    int                   n_frames = 0;
+    while (!frames.empty()) {
+        neo::lz4_frame_decompressor dec;
+        auto                        res = neo::buffer_transform(dec, out, frames);
+        REQUIRE(res.done);
+        REQUIRE_FALSE(dec.has_error());
+        frames += res.bytes_read;
+        ++n_frames;
+    }
+    CHECK(n_frames == 5);
+    CHECK(out.read_area_view() == input);
+}
+
+TEST_CASE("Exceptions from a block are rethrown in order") {
+    neo::string_dynbuf_io              out;
+    neo::parallel_block_transform_sink sink{out, throwing_transformer{}, 4, 3};
+    // The failed block may be reached by the last commit, or by finish()
+    auto write_all = [&] {
+        neo::buffer_copy(sink, neo::as_buffer(std::string_view("aaaabbbbxccc")));
+        sink.finish();
+    };
+    CHECK_THROWS_AS(write_all(), std::runtime_error);
+    // The blocks that preceded the failed block were written
+    CHECK(out.read_area_view() == "aaaabbbb");
+}
+
+TEST_CASE("Unfinished data is discarded") {
+    neo::string_dynbuf_io out;
+    {
+        neo::parallel_block_transform_sink sink{out, neo::bitnot_transformer{}, 1024, 2};
+        neo::buffer_copy(sink, neo::as_buffer(make_input(100)));
+    }
+    CHECK(out.available() == 0);
+}
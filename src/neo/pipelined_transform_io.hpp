@@ -0,0 +1,230 @@
+#pragma once
+
+#include "./as_buffer.hpp"
+#include "./buffer_algorithm/transform.hpp"
+#include "./buffer_sink.hpp"
+#include "./spsc_ring.hpp"
+
+#include <neo/fwd.hpp>
+#include <neo/ref_member.hpp>
+
+#include <array>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace neo {
+
+/**
+ * Options for a pipelined_transform_sink.
+ */
+struct pipeline_options {
+    /// The capacity of the ring buffer in front of each stage
+    std::size_t ring_capacity = 1024 * 64;
+};
+
+namespace detail {
+
+/**
+ * A buffer_sink that writes into the producer side of an spsc_byte_ring,
+ * waiting for room as needed.
+ */
+class spsc_ring_writer {
+    spsc_byte_ring* _ring;
+
+public:
+    explicit spsc_ring_writer(spsc_byte_ring& r) noexcept
+        : _ring(&r) {}
+
+    mutable_buffer prepare(std::size_t n) const noexcept {
+        return as_buffer(_ring->wait_write_area(), n);
+    }
+    void commit(std::size_t n) const noexcept { _ring->commit(n); }
+};
+
+}  // namespace detail
+
+/**
+ * A buffer_sink that passes its data through a chain of transformers, running
+ * each transformer on its own thread. The stages are linked by lock-free
+ * single-producer/single-consumer rings, so commit() returns as soon as the
+ * data has been handed to the first stage, and each stage works concurrently
+ * with the others. The final stage writes to the underlying sink.
+ *
+ * The underlying sink is written from the final stage's thread, so it must not
+ * be used by anyone else until `finish()` has returned. `finish()` waits for all
+ * data to pass through the pipeline, finishing each transformer (with
+ * `transform_finish`, if it supports it) in turn. If a stage throws an
+ * exception, that stage discards the rest of its input, and the exception is
+ * rethrown from `finish()`.
+ *
+ * Transformers given as lvalues are held by reference, and are used from their
+ * stage's thread until the pipeline is finished.
+ *
+ * If the sink is destroyed without being finished, it is finished upon
+ * destruction, and any exception is discarded.
+ */
+template <buffer_sink Sink, buffer_transformer... Stages>
+class pipelined_transform_sink {
+    static_assert(sizeof...(Stages) > 0, "pipelined_transform_sink requires at least one stage");
+
+    static constexpr std::size_t n_stages = sizeof...(Stages);
+
+    [[no_unique_address]] wrap_ref_member_t<Sink> _sink;
+
+    std::tuple<wrap_ref_member_t<Stages>...>              _stages;
+    std::array<std::unique_ptr<spsc_byte_ring>, n_stages> _rings;
+    std::array<std::exception_ptr, n_stages>              _errors;
+    std::vector<std::thread>                              _threads;
+    bool                                                  _finished = false;
+
+    template <typename Tr, typename Out>
+    static void _run_stage(Tr& tr, spsc_byte_ring& in, Out& out, std::exception_ptr& error) {
+        bool done = false;
+        try {
+            while (!done) {
+                auto avail = in.wait_read_area();
+                if (avail.empty()) {
+                    break;
+                }
+                auto res = buffer_transform(tr, out, avail);
+                in.consume(res.bytes_read);
+                done = res.done;
+            }
+            if constexpr (buffer_transformer<Tr&, transform_finish_t>) {
+                if (!done) {
+                    buffer_transform(tr, out, const_buffer(), transform_finish);
+                }
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+        // Discard whatever remains, so that the stage before us is not stuck
+        // waiting for room.
+        while (true) {
+            auto avail = in.wait_read_area();
+            if (avail.empty()) {
+                break;
+            }
+            in.consume(avail.size());
+        }
+    }
+
+    template <std::size_t I>
+    void _run_stage() {
+        auto& tr = stage<I>();
+        auto& in = *_rings[I];
+        if constexpr (I + 1 == n_stages) {
+            auto& out = sink();
+            _run_stage(tr, in, out, _errors[I]);
+        } else {
+            detail::spsc_ring_writer out{*_rings[I + 1]};
+            _run_stage(tr, in, out, _errors[I]);
+            _rings[I + 1]->close();
+        }
+    }
+
+    template <std::size_t... Is>
+    void _start(const pipeline_options& opts, std::index_sequence<Is...>) {
+        ((_rings[Is] = std::make_unique<spsc_byte_ring>(opts.ring_capacity)), ...);
+        _threads.reserve(n_stages);
+        try {
+            (_threads.emplace_back([this] { _run_stage<Is>(); }), ...);
+        } catch (...) {
+            _abort_start();
+            throw;
+        }
+    }
+
+    // A thread failed to start. Stop the stages that did start, and stand in
+    // for the first one that did not, so that its writer is not left waiting
+    // for room. No joinable thread may be left behind when the constructor throws.
+    void _abort_start() noexcept {
+        _finished = true;
+        _rings[0]->close();
+        if (!_threads.empty()) {
+            auto& orphan = *_rings[_threads.size()];
+            while (true) {
+                auto avail = orphan.wait_read_area();
+                if (avail.empty()) {
+                    break;
+                }
+                orphan.consume(avail.size());
+            }
+        }
+        for (auto& t : _threads) {
+            t.join();
+        }
+    }
+
+    void _join() noexcept {
+        if (_finished) {
+            return;
+        }
+        _finished = true;
+        _rings[0]->close();
+        for (auto& t : _threads) {
+            t.join();
+        }
+    }
+
+public:
+    explicit pipelined_transform_sink(Sink&& s, Stages&&... stages)
+        : pipelined_transform_sink(NEO_FWD(s), pipeline_options{}, NEO_FWD(stages)...) {}
+
+    explicit pipelined_transform_sink(Sink&& s, pipeline_options opts, Stages&&... stages)
+        : _sink(NEO_FWD(s))
+        , _stages(NEO_FWD(stages)...) {
+        _start(opts, std::index_sequence_for<Stages...>{});
+    }
+
+    pipelined_transform_sink(const pipelined_transform_sink&) = delete;
+    pipelined_transform_sink& operator=(const pipelined_transform_sink&) = delete;
+
+    ~pipelined_transform_sink() { _join(); }
+
+    NEO_DECL_UNREF_GETTER(sink, _sink);
+
+    /**
+     * Obtain the transformer of stage `I`. It is in use by its thread until the
+     * pipeline is finished.
+     */
+    template <std::size_t I>
+    decltype(auto) stage() noexcept {
+        return unref(std::get<I>(_stages));
+    }
+
+    mutable_buffer prepare(std::size_t n) noexcept {
+        neo_assert(expects, !_finished, "Wrote to a pipelined_transform_sink after finish()");
+        return as_buffer(_rings[0]->wait_write_area(), n);
+    }
+
+    void commit(std::size_t n) noexcept { _rings[0]->commit(n); }
+
+    /**
+     * Wait for all data to pass through the pipeline and for every stage to
+     * finish. Rethrows the first exception thrown by any stage.
+     */
+    void finish() {
+        _join();
+        for (auto& err : _errors) {
+            if (err) {
+                std::rethrow_exception(std::exchange(err, nullptr));
+            }
+        }
+    }
+};
+
+template <typename S, typename... Tr>
+explicit pipelined_transform_sink(S&&, Tr&&...) -> pipelined_transform_sink<S, Tr...>;
+
+template <typename S, typename... Tr>
+explicit pipelined_transform_sink(S&&, pipeline_options, Tr&&...)
+    -> pipelined_transform_sink<S, Tr...>;
+
+}  // namespace neo
@@ -0,0 +1,128 @@
+#include <neo/pipelined_transform_io.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/bitwise_transform.hpp>
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/checksum.hpp>
+#include <neo/compose_transform.hpp>
+#include <neo/hex.hpp>
+#include <neo/lz4.hpp>
+#include <neo/string_io.hpp>
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+NEO_TEST_CONCEPT(
+    neo::buffer_sink<neo::pipelined_transform_sink<neo::string_dynbuf_io&, neo::hex_encoder>>);
+
+namespace {
+
+std::string make_input(std::size_t size) {
+    std::string ret;
+    for (std::size_t i = 0; i < size; ++i) {
+        ret.push_back(static_cast<char>(i * 7 + 3));
+    }
+    return ret;
+}
+
+template <typename Transformer>
+std::string transform_all(std::string_view in, Transformer&& tr) {
+    neo::string_dynbuf_io out;
+    neo::buffer_transform(tr, out, neo::as_buffer(in));
+    if constexpr (neo::buffer_transformer<Transformer, neo::transform_finish_t>) {
+        neo::buffer_transform(tr, out, neo::const_buffer(), neo::transform_finish);
+    }
+    return std::string(out.read_area_view());
+}
+
+/// Throws once it sees an 'x'
+struct throwing_transformer {
+    neo::simple_transform_result operator()(neo::mutable_buffer out, neo::const_buffer in) const {
+        auto n = neo::buffer_copy(out, in);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (in[i] == std::byte('x')) {
+                throw std::runtime_error("bad byte");
+            }
+        }
+        return {n, n, false};
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Pipeline a single stage") {
+    const auto size     = GENERATE(0u, 1u, 1000u, 100000u);
+    const auto ring_cap = GENERATE(1u, 64u, 65536u);
+    const auto input    = make_input(size);
+
+    neo::string_dynbuf_io         out;
+    neo::pipelined_transform_sink sink{out, neo::pipeline_options{ring_cap}, neo::hex_encoder{}};
+    for (std::size_t pos = 0, len = 1; pos < input.size(); pos += len, len += 333) {
+        neo::buffer_copy(sink, neo::as_buffer(input) + pos, len);
+    }
+    sink.finish();
+    CHECK(out.read_area_view() == transform_all(input, neo::hex_encoder{}));
+}
+
+TEST_CASE("Pipeline several stages") {
+    const auto input    = make_input(200000);
+    const auto ring_cap = GENERATE(16u, 4096u, 65536u);
+
+    neo::xxhash32_transformer checksum;
+    neo::string_dynbuf_io     out;
+    {
+        neo::pipelined_transform_sink sink{out,
+                                           neo::pipeline_options{ring_cap},
+                                           checksum,
+                                           neo::lz4_frame_compressor{},
+                                           neo::hex_encoder{}};
+        for (std::size_t pos = 0, len = 1; pos < input.size(); pos += len, len += 1013) {
+            neo::buffer_copy(sink, neo::as_buffer(input) + pos, len);
+        }
+        sink.finish();
+    }
+
+    // The result matches running the same stages one after the other
+    auto chain = neo::compose_transformers(neo::xxhash32_transformer{},
+                                           neo::lz4_frame_compressor{},
+                                           neo::hex_encoder{});
+    CHECK(out.read_area_view() == transform_all(input, chain));
+
+    // The first stage was held by reference
+    neo::xxhash32_digest expect_sum;
+    expect_sum.update(neo::as_buffer(input));
+    CHECK(checksum.digest().digest() == expect_sum.digest());
+}
+
+TEST_CASE("Unfinished pipelines finish on destruction") {
+    const auto            input = make_input(5000);
+    neo::string_dynbuf_io out;
+    {
+        neo::pipelined_transform_sink sink{out, neo::bitnot_transformer{}, neo::hex_encoder{}};
+        neo::buffer_copy(sink, neo::as_buffer(input));
+    }
+    auto inverted = transform_all(input, neo::bitnot_transformer{});
+    CHECK(out.read_area_view() == transform_all(inverted, neo::hex_encoder{}));
+}
+
+TEST_CASE("Exceptions from a stage are rethrown by finish()") {
+    auto input = make_input(100000);
+    input[50000] = 'x';
+
+    neo::string_dynbuf_io         out;
+    neo::pipelined_transform_sink sink{out,
+                                       neo::pipeline_options{256},
+                                       neo::bitnot_transformer{},
+                                       neo::bitnot_transformer{},
+                                       throwing_transformer{},
+                                       neo::hex_encoder{}};
+    // Writing the rest of the data does not block after the stage fails
+    neo::buffer_copy(sink, neo::as_buffer(input));
+    CHECK_THROWS_AS(sink.finish(), std::runtime_error);
+    // The error is only reported once
+    CHECK_NOTHROW(sink.finish());
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "./arena_dynamic_buffer.hpp"
+#include "./bytes.hpp"
+#include "./dynbuf_io.hpp"
+#include "./iostream_io.hpp"
+#include "./shifting_dynamic_buffer.hpp"
+#include "./string_io.hpp"
+#include "./transform_io.hpp"
+
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+/**
+ * Aliases of the library's buffer types that draw their memory from a
+ * `std::pmr::memory_resource` rather than the global allocator. Each type that
+ * owns storage can be constructed from a resource pointer, and otherwise uses
+ * `std::pmr::get_default_resource()`.
+ */
+namespace neo::pmr {
+
+using bytes = basic_bytes<std::pmr::polymorphic_allocator<std::byte>>;
+
+template <as_dynamic_buffer_convertible Storage = std::pmr::string>
+using shifting_dynamic_buffer = neo::shifting_dynamic_buffer<Storage>;
+
+struct shifting_string_buffer : shifting_dynamic_buffer<std::pmr::string> {
+    shifting_string_buffer() = default;
+
+    explicit shifting_string_buffer(std::pmr::memory_resource* resource)
+        : shifting_dynamic_buffer(std::pmr::string(resource)) {}
+};
+
+struct string_dynbuf_io : dynbuf_io<std::pmr::string> {
+    using dynbuf_io::dynbuf_io;
+
+    string_dynbuf_io() = default;
+
+    explicit string_dynbuf_io(std::pmr::memory_resource* resource)
+        : dynbuf_io(std::pmr::string(resource)) {}
+
+    decltype(auto) string() & noexcept { return storage(); }
+    decltype(auto) string() const& noexcept { return storage(); }
+    decltype(auto) string() && noexcept { return std::move(*this).storage(); }
+
+    std::string_view read_area_view() const noexcept {
+        return std::string_view(string()).substr(0, available());
+    }
+};
+
+struct shifting_string_dynbuf_io : dynbuf_io<shifting_string_buffer> {
+    using dynbuf_io::dynbuf_io;
+
+    shifting_string_dynbuf_io() = default;
+
+    explicit shifting_string_dynbuf_io(std::pmr::memory_resource* resource)
+        : dynbuf_io(shifting_string_buffer(resource)) {}
+
+    decltype(auto) string() & noexcept { return storage().storage(); }
+    decltype(auto) string() const& noexcept { return storage().storage(); }
+    decltype(auto) string() && noexcept { return std::move(*this).storage().storage(); }
+
+    std::string_view read_area_view() const noexcept {
+        return std::string_view(storage().data(0, available()));
+    }
+};
+
+/**
+ * A dynbuf_io over an arena_dynamic_buffer, for request-scoped I/O whose memory
+ * is released in bulk with its arena.
+ */
+struct arena_dynbuf_io : dynbuf_io<arena_dynamic_buffer> {
+    using dynbuf_io::dynbuf_io;
+
+    arena_dynbuf_io() = default;
+
+    explicit arena_dynbuf_io(std::pmr::memory_resource* resource)
+        : dynbuf_io(arena_dynamic_buffer(resource)) {}
+};
+
+template <typename Stream, dynamic_buffer DynBuffer = shifting_string_buffer>
+using iostream_io = neo::iostream_io<Stream, DynBuffer>;
+
+template <buffer_sink        Sink,
+          buffer_transformer Transform,
+          dynamic_buffer     DynBuffer = shifting_string_buffer>
+using buffer_transform_sink = neo::buffer_transform_sink<Sink, Transform, DynBuffer>;
+
+template <buffer_source      Source,
+          buffer_transformer Transform,
+          dynamic_buffer     DynBuffer = shifting_string_buffer>
+using buffer_transform_source = neo::buffer_transform_source<Source, Transform, DynBuffer>;
+
+}  // namespace neo::pmr
@@ -0,0 +1,69 @@
+#include <neo/pmr.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/bitwise_transform.hpp>
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+
+NEO_TEST_CONCEPT(neo::dynamic_buffer<neo::pmr::shifting_string_buffer>);
+NEO_TEST_CONCEPT(neo::buffer_sink<neo::pmr::string_dynbuf_io>);
+NEO_TEST_CONCEPT(neo::buffer_source<neo::pmr::shifting_string_dynbuf_io>);
+NEO_TEST_CONCEPT(neo::buffer_sink<neo::pmr::arena_dynbuf_io>);
+
+TEST_CASE("Use pmr buffer types with a memory resource") {
+    std::array<std::byte, 1024 * 64>    storage;
+    std::pmr::monotonic_buffer_resource arena{storage.data(),
+                                              storage.size(),
+                                              std::pmr::null_memory_resource()};
+
+    neo::pmr::bytes b{std::pmr::polymorphic_allocator<std::byte>(&arena)};
+    b.resize(100, std::byte{7});
+    CHECK(b.get_allocator().resource() == &arena);
+
+    neo::pmr::string_dynbuf_io io{&arena};
+    CHECK(io.string().get_allocator().resource() == &arena);
+    neo::buffer_copy(io, neo::as_buffer("Hello, arena!", 13));
+    CHECK(io.read_area_view() == "Hello, arena!");
+
+    neo::pmr::shifting_string_dynbuf_io shifting{&arena};
+    neo::buffer_copy(shifting, neo::as_buffer("Shifted", 7));
+    shifting.consume(2);
+    CHECK(shifting.read_area_view() == "ifted");
+    CHECK(shifting.string().get_allocator().resource() == &arena);
+
+    neo::pmr::arena_dynbuf_io req{&arena};
+    neo::buffer_copy(req, neo::as_buffer("request", 7));
+    CHECK(req.buffer().resource() == &arena);
+    CHECK(req.available() == 7);
+
+    // Without an arena, the storage is given back to the default resource
+    neo::pmr::arena_dynbuf_io dflt;
+    neo::buffer_copy(dflt, neo::as_buffer(std::string(5000, 'd')));
+    CHECK(dflt.buffer().resource() == std::pmr::get_default_resource());
+    CHECK(dflt.available() == 5000);
+}
+
+TEST_CASE("Transform through pmr-backed buffers") {
+    std::pmr::monotonic_buffer_resource arena;
+
+    std::ostringstream                      out;
+    neo::pmr::iostream_io<std::ostream&>    ios{out};
+    neo::pmr::shifting_string_buffer        buf{&arena};
+    neo::pmr::buffer_transform_sink<decltype(ios)&, neo::bitnot_transformer, decltype(buf)&> sink{
+        ios,
+        neo::bitnot_transformer{},
+        buf};
+    std::string input = "some text";
+    neo::buffer_copy(sink, neo::as_buffer(input));
+    for (auto& c : input) {
+        c = static_cast<char>(~c);
+    }
+    CHECK(out.str() == input);
+}
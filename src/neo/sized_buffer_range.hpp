@@ -0,0 +1,70 @@
+#pragma once
+
+#include <neo/buffer_algorithm/size.hpp>
+#include <neo/buffer_range.hpp>
+
+#include <neo/assert.hpp>
+#include <neo/fwd.hpp>
+#include <neo/ref_member.hpp>
+
+#include <iterator>
+
+namespace neo {
+
+/**
+ * Wrap a buffer range and remember its total size in bytes. The size is computed once upon
+ * construction, and all subsequent calls to `buffer_size`, `buffer_size_at_least`, and
+ * `buffer_is_empty` on the wrapper are constant-time.
+ *
+ * NOTE: If `Range` is a reference type and the referred-to range is modified after the
+ * sized_buffer_range is constructed, the remembered size will be stale.
+ */
+template <buffer_range Range>
+class sized_buffer_range {
+public:
+    using range_type = std::remove_cvref_t<Range>;
+
+private:
+    [[no_unique_address]] wrap_ref_member_t<Range> _range;
+
+    std::size_t _size = 0;
+
+public:
+    constexpr sized_buffer_range() = default;
+
+    constexpr explicit sized_buffer_range(Range&& rng) noexcept
+        : _range(NEO_FWD(rng))
+        , _size(neo::buffer_size(range())) {}
+
+    /**
+     * Construct a sized range with a size that is already known to the caller. The given size
+     * must be equal to the buffer_size() of the range.
+     */
+    constexpr sized_buffer_range(Range&& rng, std::size_t size) noexcept
+        : _range(NEO_FWD(rng))
+        , _size(size) {
+        neo_assert(expects,
+                   size == neo::buffer_size(range()),
+                   "sized_buffer_range was given a size that does not match its range",
+                   size,
+                   neo::buffer_size(range()));
+    }
+
+    NEO_DECL_UNREF_GETTER(range, _range);
+
+    /// Obtain the total number of bytes in the range
+    [[nodiscard]] constexpr std::size_t buffer_size() const noexcept { return _size; }
+
+    constexpr auto begin() const noexcept(noexcept(std::begin(range()))) {
+        return std::begin(range());
+    }
+    constexpr auto end() const noexcept(noexcept(std::end(range()))) { return std::end(range()); }
+};
+
+template <typename Range>
+explicit sized_buffer_range(Range&&) -> sized_buffer_range<Range>;
+
+template <typename Range>
+sized_buffer_range(Range&&, std::size_t) -> sized_buffer_range<Range>;
+
+}  // namespace neo
@@ -0,0 +1,61 @@
+#include <neo/sized_buffer_range.hpp>
+
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffers_cat.hpp>
+
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <string>
+
+NEO_TEST_CONCEPT(neo::buffer_range<neo::sized_buffer_range<neo::proto_buffer_range>>);
+NEO_TEST_CONCEPT(
+    neo::mutable_buffer_range<neo::sized_buffer_range<neo::proto_mutable_buffer_range>>);
+
+namespace {
+
+/// A buffer range that counts how many times it has been iterated
+struct counted_range {
+    std::array<neo::const_buffer, 2> bufs     = {neo::const_buffer("foo"), neo::const_buffer("bar")};
+    mutable int                      n_begins = 0;
+
+    auto begin() const noexcept {
+        ++n_begins;
+        return bufs.begin();
+    }
+    auto end() const noexcept { return bufs.end(); }
+};
+
+}  // namespace
+
+TEST_CASE("Size a range once") {
+    counted_range           rng;
+    neo::sized_buffer_range sized{rng};
+    CHECK(rng.n_begins == 1);
+    CHECK(neo::buffer_size(sized) == 6);
+    CHECK(neo::buffer_size_at_least(sized, 6));
+    CHECK_FALSE(neo::buffer_size_at_least(sized, 7));
+    CHECK_FALSE(neo::buffer_is_empty(sized));
+    // None of the size queries walked the range again
+    CHECK(rng.n_begins == 1);
+
+    std::string str;
+    str.resize(6);
+    neo::buffer_copy(neo::as_buffer(str), sized);
+    CHECK(str == "foobar");
+}
+
+TEST_CASE("Concatenate sized ranges") {
+    counted_range rng;
+    auto          cat = neo::buffers_cat(neo::sized_buffer_range{rng}, neo::const_buffer("baz"));
+    CHECK(rng.n_begins == 1);
+    CHECK(neo::buffer_size(cat) == 9);
+    CHECK(rng.n_begins == 1);
+
+    std::string str;
+    str.resize(9);
+    neo::buffer_copy(neo::as_buffer(str), cat);
+    CHECK(str == "foobarbaz");
+}
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <neo/const_buffer.hpp>
+#include <neo/mutable_buffer.hpp>
+#include <neo/static_buffer_vector.hpp>
+
+#include <neo/assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+
+namespace neo {
+
+class spsc_ring_producer;
+class spsc_ring_consumer;
+
+/**
+ * A fixed-capacity ring of bytes that passes data from one producer thread to
+ * one consumer thread without locks.
+ *
+ * The producer writes into `write_area()` and publishes with `commit()`; the
+ * consumer reads from `read_area()` and releases with `consume()`. Each side
+ * may instead use the `wait_` variants, which block until there is room or
+ * data. The producer calls `close()` once it has no more data, after which the
+ * consumer sees an empty read area once it has drained the ring.
+ *
+ * The head and tail indices live on separate cache lines so that the two
+ * threads do not contend over them.
+ *
+ * `producer()` and `consumer()` give handles to either side of the ring that
+ * model buffer_sink and buffer_source, respectively.
+ */
+class spsc_byte_ring {
+public:
+    static constexpr std::size_t cache_line_size = 64;
+
+private:
+    // The top bit of the head index is set once the producer has closed the
+    // ring, so that a consumer waiting for the head to move is woken by it.
+    static constexpr std::size_t closed_bit = ~(~std::size_t(0) >> 1);
+
+    std::unique_ptr<std::byte[]> _data;
+    std::size_t                  _capacity = 0;
+
+    /// The total number of bytes ever written. Modified only by the producer.
+    alignas(cache_line_size) std::atomic<std::size_t> _head{0};
+    /// The total number of bytes ever read. Modified only by the consumer.
+    alignas(cache_line_size) std::atomic<std::size_t> _tail{0};
+    // Keep the tail's cache line to itself
+    [[maybe_unused]] char _pad[cache_line_size - sizeof(std::atomic<std::size_t>)];
+
+    std::byte* _at(std::size_t index) const noexcept {
+        return _data.get() + (index & (_capacity - 1));
+    }
+
+public:
+    /**
+     * Create a ring that holds at least `min_capacity` bytes. The capacity is
+     * rounded up to a power of two.
+     */
+    explicit spsc_byte_ring(std::size_t min_capacity)
+        : _capacity(std::bit_ceil((std::max)(min_capacity, std::size_t(1)))) {
+        _data.reset(new std::byte[_capacity]);
+    }
+
+    spsc_byte_ring(const spsc_byte_ring&) = delete;
+    spsc_byte_ring& operator=(const spsc_byte_ring&) = delete;
+
+    std::size_t capacity() const noexcept { return _capacity; }
+
+    /**
+     * [Producer] Obtain the contiguous free space following the data that has
+     * been written. It may be smaller than the total free space if it reaches
+     * the end of the ring's storage.
+     */
+    mutable_buffer write_area() const noexcept {
+        const auto head = _head.load(std::memory_order_relaxed) & ~closed_bit;
+        const auto tail = _tail.load(std::memory_order_acquire);
+        const auto free = _capacity - (head - tail);
+        const auto run  = _capacity - (head & (_capacity - 1));
+        return mutable_buffer(_at(head), (std::min)(free, run));
+    }
+
+    /// [Producer] Like write_area(), but waits until there is room to write
+    mutable_buffer wait_write_area() const noexcept {
+        while (true) {
+            auto area = write_area();
+            if (!area.empty()) {
+                return area;
+            }
+            const auto head = _head.load(std::memory_order_relaxed) & ~closed_bit;
+            _tail.wait(head - _capacity, std::memory_order_acquire);
+        }
+    }
+
+    /// [Producer] Publish `n` bytes written into the write area
+    void commit(std::size_t n) noexcept {
+        const auto head = _head.load(std::memory_order_relaxed);
+        const auto used = (head & ~closed_bit) - _tail.load(std::memory_order_relaxed);
+        neo_assert(expects,
+                   n <= _capacity - used,
+                   "Committed more bytes to an spsc_byte_ring than there was room for",
+                   n,
+                   _capacity);
+        _head.store(head + n, std::memory_order_release);
+        _head.notify_one();
+    }
+
+    /// [Producer] Declare that no more data will be written
+    void close() noexcept {
+        _head.fetch_or(closed_bit, std::memory_order_release);
+        _head.notify_one();
+    }
+
+    /**
+     * [Consumer] Obtain the contiguous data that is ready to be read. It may be
+     * less than all of the data if it reaches the end of the ring's storage.
+     */
+    const_buffer read_area() const noexcept {
+        const auto head  = _head.load(std::memory_order_acquire) & ~closed_bit;
+        const auto tail  = _tail.load(std::memory_order_relaxed);
+        const auto avail = head - tail;
+        const auto run   = _capacity - (tail & (_capacity - 1));
+        return const_buffer(_at(tail), (std::min)(avail, run));
+    }
+
+    /**
+     * [Consumer] Like read_area(), but waits until there is data to read. An
+     * empty buffer is returned only once the ring is closed and drained.
+     */
+    const_buffer wait_read_area() const noexcept {
+        while (true) {
+            const auto head = _head.load(std::memory_order_acquire);
+            auto       area = read_area();
+            if (!area.empty() || (head & closed_bit)) {
+                return area;
+            }
+            _head.wait(head, std::memory_order_acquire);
+        }
+    }
+
+    /// [Consumer] Release `n` bytes of the read area back to the producer
+    void consume(std::size_t n) noexcept {
+        const auto tail = _tail.load(std::memory_order_relaxed);
+        neo_assert(expects,
+                   n <= (_head.load(std::memory_order_relaxed) & ~closed_bit) - tail,
+                   "Consumed more bytes from an spsc_byte_ring than were available",
+                   n);
+        _tail.store(tail + n, std::memory_order_release);
+        _tail.notify_one();
+    }
+
+    /**
+     * [Producer] Obtain up to `max` bytes of the free space following the
+     * data that has been written. If the space wraps around the end of the
+     * ring's storage, it is given as two buffers. Never waits.
+     */
+    static_buffer_vector<mutable_buffer, 2> write_areas(std::size_t max) const noexcept {
+        const auto head = _head.load(std::memory_order_relaxed) & ~closed_bit;
+        const auto tail = _tail.load(std::memory_order_acquire);
+        return _split<mutable_buffer>(head, (std::min)(_capacity - (head - tail), max));
+    }
+
+    /**
+     * [Consumer] Obtain up to `max` bytes of the data that is ready to be
+     * read. If the data wraps around the end of the ring's storage, it is given
+     * as two buffers. Never waits.
+     */
+    static_buffer_vector<const_buffer, 2> read_areas(std::size_t max) const noexcept {
+        const auto head = _head.load(std::memory_order_acquire) & ~closed_bit;
+        const auto tail = _tail.load(std::memory_order_relaxed);
+        return _split<const_buffer>(tail, (std::min)(head - tail, max));
+    }
+
+    /// Whether the producer has closed the ring
+    bool closed() const noexcept { return _head.load(std::memory_order_acquire) & closed_bit; }
+
+    /// Obtain a buffer_sink that writes into this ring. Only one thread may use it.
+    spsc_ring_producer producer() noexcept;
+    /// Obtain a buffer_source that reads from this ring. Only one thread may use it.
+    spsc_ring_consumer consumer() noexcept;
+
+private:
+    template <typename Buffer>
+    static_buffer_vector<Buffer, 2> _split(std::size_t index, std::size_t size) const noexcept {
+        static_buffer_vector<Buffer, 2> ret;
+        if (size == 0) {
+            return ret;
+        }
+        const auto run = (std::min)(size, _capacity - (index & (_capacity - 1)));
+        ret.push_back(Buffer(_at(index), run));
+        if (run != size) {
+            ret.push_back(Buffer(_data.get(), size - run));
+        }
+        return ret;
+    }
+};
+
+/**
+ * The producer side of an spsc_byte_ring, as a buffer_sink. `prepare()` gives
+ * as much of the requested space as is free right now, which may be less than
+ * was asked for, or none at all if the consumer has fallen behind. It never
+ * waits, so copying into a full ring copies fewer bytes than requested.
+ */
+class spsc_ring_producer {
+    spsc_byte_ring* _ring;
+
+public:
+    explicit spsc_ring_producer(spsc_byte_ring& r) noexcept
+        : _ring(&r) {}
+
+    spsc_byte_ring& ring() const noexcept { return *_ring; }
+
+    static_buffer_vector<mutable_buffer, 2> prepare(std::size_t n) const noexcept {
+        return _ring->write_areas(n);
+    }
+    void commit(std::size_t n) const noexcept { _ring->commit(n); }
+
+    /// Declare that no more data will be written
+    void close() const noexcept { _ring->close(); }
+};
+
+/**
+ * The consumer side of an spsc_byte_ring, as a buffer_source. `next()` gives as
+ * much of the requested data as is available right now, and never waits. An
+ * empty result means either that the producer has not caught up, or, once
+ * `at_end()` is true, that all of the data has been read.
+ */
+class spsc_ring_consumer {
+    spsc_byte_ring* _ring;
+
+public:
+    explicit spsc_ring_consumer(spsc_byte_ring& r) noexcept
+        : _ring(&r) {}
+
+    spsc_byte_ring& ring() const noexcept { return *_ring; }
+
+    static_buffer_vector<const_buffer, 2> next(std::size_t n) const noexcept {
+        return _ring->read_areas(n);
+    }
+    void consume(std::size_t n) const noexcept { _ring->consume(n); }
+
+    /// Whether the producer has closed the ring and every byte has been read
+    bool at_end() const noexcept {
+        // Check for closure first, so that data committed just before closing
+        // is not missed
+        return _ring->closed() && _ring->read_area().empty();
+    }
+};
+
+inline spsc_ring_producer spsc_byte_ring::producer() noexcept { return spsc_ring_producer{*this}; }
+inline spsc_ring_consumer spsc_byte_ring::consumer() noexcept { return spsc_ring_consumer{*this}; }
+
+}  // namespace neo
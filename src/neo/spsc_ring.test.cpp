@@ -0,0 +1,120 @@
+#include <neo/spsc_ring.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffer_sink.hpp>
+#include <neo/buffer_source.hpp>
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <string_view>
+#include <thread>
+
+NEO_TEST_CONCEPT(neo::buffer_sink<neo::spsc_ring_producer>);
+NEO_TEST_CONCEPT(neo::buffer_source<neo::spsc_ring_consumer>);
+
+namespace {
+
+std::string make_input(std::size_t size) {
+    std::string ret;
+    for (std::size_t i = 0; i < size; ++i) {
+        ret.push_back(static_cast<char>(i * 7 + 3));
+    }
+    return ret;
+}
+
+}  // namespace
+
+TEST_CASE("Ring areas split at the wrap point") {
+    neo::spsc_byte_ring ring{8};
+    auto                prod = ring.producer();
+    auto                cons = ring.consumer();
+
+    CHECK(neo::buffer_size(prod.prepare(100)) == 8);
+    CHECK(neo::buffer_copy(prod, neo::as_buffer("abcdef", 6)) == 6);
+    CHECK(neo::buffer_size(cons.next(100)) == 6);
+    cons.consume(4);
+
+    // The free space now runs off the end of the storage and back around
+    auto free = prod.prepare(100);
+    REQUIRE(free.size() == 2);
+    CHECK(free[0].size() == 2);
+    CHECK(free[1].size() == 4);
+    CHECK(free[1].data() == free[0].data() - 6);
+    CHECK(neo::buffer_copy(prod, neo::as_buffer("ghijklmn", 8)) == 6);
+
+    auto data = cons.next(100);
+    REQUIRE(data.size() == 2);
+    CHECK(neo::buffer_size(data) == 8);
+    std::string got(8, '\0');
+    CHECK(neo::buffer_copy(neo::as_buffer(got), cons) == 8);
+    CHECK(got == "efghijkl");
+
+    CHECK(neo::buffer_size(cons.next(100)) == 0);
+    CHECK_FALSE(cons.at_end());
+    prod.close();
+    CHECK(cons.at_end());
+}
+
+TEST_CASE("Pass data through ring handles between threads") {
+    const auto cap   = GENERATE(1u, 100u, 4096u);
+    const auto input = make_input(100000);
+
+    neo::spsc_byte_ring ring{cap};
+    std::string         got;
+    std::thread         consumer{[&, cons = ring.consumer()] {
+        char buf[97];
+        while (!cons.at_end()) {
+            auto n = neo::buffer_copy(neo::as_buffer(buf), cons);
+            got.append(buf, n);
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+        }
+    }};
+
+    auto              prod = ring.producer();
+    neo::const_buffer rest = neo::as_buffer(input);
+    while (!rest.empty()) {
+        auto n = neo::buffer_copy(prod, rest, 333);
+        rest += n;
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+    }
+    prod.close();
+    consumer.join();
+    CHECK(got == input);
+}
+
+TEST_CASE("Blocking ring waits for room and data") {
+    neo::spsc_byte_ring ring{100};
+    CHECK(ring.capacity() == 128);
+
+    const auto  input = make_input(100000);
+    std::string got;
+    std::thread consumer{[&] {
+        while (true) {
+            auto area = ring.wait_read_area();
+            if (area.empty()) {
+                break;
+            }
+            got.append(reinterpret_cast<const char*>(area.data()), area.size());
+            ring.consume(area.size());
+        }
+    }};
+    for (std::size_t pos = 0, len = 1; pos < input.size(); pos += len, len = len % 300 + 17) {
+        auto chunk = neo::as_buffer(neo::as_buffer(input) + pos, len);
+        while (!chunk.empty()) {
+            auto n = neo::buffer_copy(ring.wait_write_area(), chunk);
+            ring.commit(n);
+            chunk += n;
+        }
+    }
+    ring.close();
+    consumer.join();
+    CHECK(ring.closed());
+    CHECK(got == input);
+}
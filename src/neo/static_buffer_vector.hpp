@@ -32,6 +32,12 @@ struct static_buffer_vector {
     constexpr std::size_t size() const noexcept { return active_count; }
     constexpr std::size_t max_size() const noexcept { return MaxBuffers; }
 
+    /**
+     * Obtain a pointer to the contiguous array of active buffers.
+     */
+    constexpr pointer       data() noexcept { return buffers; }
+    constexpr const_pointer data() const noexcept { return buffers; }
+
     constexpr const_iterator cbegin() const noexcept { return buffers; }
     constexpr const_iterator begin() const noexcept { return cbegin(); }
     constexpr iterator       begin() noexcept { return buffers; }
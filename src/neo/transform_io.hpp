@@ -1,6 +1,7 @@
 #pragma once
 
 #include "./as_dynamic_buffer.hpp"
+#include "./buffer_algorithm/copy.hpp"
 #include "./buffer_algorithm/transform.hpp"
 #include "./buffer_sink.hpp"
 #include "./string_io.hpp"
@@ -9,6 +10,8 @@
 #include <neo/ref_member.hpp>
 
 #include <string>
+#include <type_traits>
+#include <utility>
 
 namespace neo {
 
@@ -20,6 +23,17 @@ class buffer_transform_sink {
     [[no_unique_address]] wrap_ref_member_t<Transform> _transformer;
     [[no_unique_address]] wrap_ref_member_t<DynBuffer> _buffer;
 
+    // If the transformer can work in-place and the sink hands out a plain
+    // buffer, then callers write directly into the sink's buffer, and it is
+    // transformed there upon commit().
+    constexpr static bool _transform_inplace
+        = buffer_transformer_is_inplace_safe_v<std::remove_cvref_t<Transform>>  //
+        && single_mutable_buffer<decltype(unref(_sink).prepare(std::size_t()))>;
+
+    struct _no_prepared {};
+    [[no_unique_address]] std::conditional_t<_transform_inplace, mutable_buffer, _no_prepared>
+        _prepared;
+
 public:
     constexpr buffer_transform_sink() = default;
     constexpr explicit buffer_transform_sink(Sink&& s) noexcept
@@ -38,7 +52,25 @@ public:
     NEO_DECL_UNREF_GETTER(transformer, _transformer);
     NEO_DECL_UNREF_GETTER(buffer, _buffer);
 
-    auto prepare(std::size_t prep_size) noexcept(noexcept(buffer().grow(prep_size))) {
+    mutable_buffer prepare(std::size_t prep_size) noexcept(noexcept(sink().prepare(prep_size)))  //
+        requires _transform_inplace                                                            //
+    {
+        _prepared = sink().prepare(prep_size);
+        return _prepared;
+    }
+
+    void commit(std::size_t n) noexcept(noexcept(sink().commit(n))
+                                        && noexcept(buffer_transform_inplace(transformer(),
+                                                                             mutable_buffer())))  //
+        requires _transform_inplace                                                              //
+    {
+        auto res = buffer_transform_inplace(transformer(), _prepared.first(n));
+        sink().commit(res.bytes_written);
+    }
+
+    auto prepare(std::size_t prep_size) noexcept(noexcept(buffer().grow(prep_size)))  //
+        requires(!_transform_inplace)                                                 //
+    {
         auto& buf   = buffer();
         auto  avail = buf.size();
         if (avail >= prep_size) {
@@ -51,12 +83,27 @@ public:
 
     void commit(std::size_t n) noexcept(
         noexcept(buffer_transform(transformer(), sink(), buffer().data(1, 1))))  //
+        requires(!_transform_inplace)                                            //
     {
         auto&  buf     = buffer();
         auto&& databuf = buf.data(0, n);
         buffer_transform(transformer(), sink(), databuf);
         buf.consume(n);
     }
+
+    /**
+     * Finish the transformation by calling the transformer with
+     * `transform_finish`. Writes any data that the transformer has held back
+     * to the underlying sink.
+     */
+    auto finish() noexcept(noexcept(buffer_transform(transformer(),
+                                                     sink(),
+                                                     const_buffer(),
+                                                     transform_finish)))  //
+        requires buffer_transformer<Transform, transform_finish_t>        //
+    {
+        return buffer_transform(transformer(), sink(), const_buffer(), transform_finish);
+    }
 };
 
 template <typename S, typename Tr>
@@ -75,25 +122,19 @@ class buffer_transform_source {
 
     std::size_t _avail = unref(_buffer).size();
 
-public:
-    constexpr buffer_transform_source() = default;
-    constexpr explicit buffer_transform_source(Source&& s) noexcept
-        : _source(NEO_FWD(s)) {}
-
-    constexpr explicit buffer_transform_source(Source&& s, Transform&& tr) noexcept
-        : _source(NEO_FWD(s))
-        , _transformer(NEO_FWD(tr)) {}
+    // If the transformer can pass data through unchanged, then the source's
+    // own buffers are handed out when possible. `_borrowed` counts the bytes
+    // at the front of the source that the transformer has passed through.
+    constexpr static bool _borrowing
+        = buffer_passthrough_transformer<std::remove_cvref_t<Transform>>
+        && single_buffer<decltype(unref(_source).next(std::size_t()))>;
 
-    constexpr explicit buffer_transform_source(Source&& s, Transform&& tr, DynBuffer&& db) noexcept
-        : _source(NEO_FWD(s))
-        , _transformer(NEO_FWD(tr))
-        , _buffer(NEO_FWD(db)) {}
+    std::size_t _borrowed = 0;
 
-    NEO_DECL_UNREF_GETTER(source, _source);
-    NEO_DECL_UNREF_GETTER(transformer, _transformer);
-    NEO_DECL_UNREF_GETTER(buffer, _buffer);
+    // Set once finish() has written out everything the transformer held back
+    bool _finished = false;
 
-    auto next(std::size_t want_size)                                                        //
+    auto _next_staged(std::size_t want_size)                                                //
         noexcept(noexcept(buffer().grow(want_size)) &&                                      //
                  noexcept(buffer_transform(transformer(), buffer().data(1, 1), source())))  //
     {
@@ -119,7 +160,107 @@ public:
         return buf.data(0, give);
     }
 
+public:
+    constexpr buffer_transform_source() = default;
+    constexpr explicit buffer_transform_source(Source&& s) noexcept
+        : _source(NEO_FWD(s)) {}
+
+    constexpr explicit buffer_transform_source(Source&& s, Transform&& tr) noexcept
+        : _source(NEO_FWD(s))
+        , _transformer(NEO_FWD(tr)) {}
+
+    constexpr explicit buffer_transform_source(Source&& s, Transform&& tr, DynBuffer&& db) noexcept
+        : _source(NEO_FWD(s))
+        , _transformer(NEO_FWD(tr))
+        , _buffer(NEO_FWD(db)) {}
+
+    NEO_DECL_UNREF_GETTER(source, _source);
+    NEO_DECL_UNREF_GETTER(transformer, _transformer);
+    NEO_DECL_UNREF_GETTER(buffer, _buffer);
+
+    const_buffer next(std::size_t want_size)                                            //
+        noexcept(noexcept(source().next(want_size)) && noexcept(_next_staged(want_size))  //
+                 && noexcept(transformer().passthrough(const_buffer())))                  //
+        requires _borrowing                                                               //
+    {
+        // Data that was already transformed into our buffer must be given first
+        if (_avail == 0) {
+            const_buffer upstream = source().next(want_size);
+            if (_borrowed == 0 && !upstream.empty()) {
+                _borrowed = transformer().passthrough(upstream);
+                neo_assert(invariant,
+                           _borrowed <= upstream.size(),
+                           "Transformer passed through more bytes than it was given",
+                           _borrowed,
+                           upstream.size());
+            }
+            if (_borrowed != 0) {
+                return upstream.first((std::min)(_borrowed, upstream.size()));
+            }
+        }
+        return const_buffer(_next_staged(want_size));
+    }
+
+    auto next(std::size_t want_size) noexcept(noexcept(_next_staged(want_size)))  //
+        requires(!_borrowing)                                                     //
+    {
+        return _next_staged(want_size);
+    }
+
+    /**
+     * Declare that the upstream source has reached the end of its data. Any
+     * data that it still holds is transformed, and then the transformer is
+     * called with `transform_finish`. All of the output becomes available from
+     * `next()`.
+     *
+     * A source that gives nothing from `next()` has not necessarily ended (e.g.
+     * a ring buffer that is waiting on its producer), so this is never inferred.
+     */
+    void finish()                                                   //
+        requires buffer_transformer<Transform, transform_finish_t>  //
+    {
+        auto& buf = buffer();
+        if constexpr (_borrowing) {
+            if (_borrowed != 0) {
+                // Bytes that were passed through must come before the finished output, so
+                // move them into our buffer.
+                if (buf.size() - _avail < _borrowed) {
+                    dynbuf_safe_grow(buf, _borrowed - (buf.size() - _avail));
+                }
+                buffer_copy(buf.data(_avail, _borrowed), source().next(_borrowed));
+                source().consume(_borrowed);
+                _avail += std::exchange(_borrowed, 0);
+            }
+        }
+        constexpr auto grow_size
+            = buffer_transform_dynamic_growth_hint_v<std::remove_cvref_t<Transform>>;
+        while (!_finished) {
+            if (buf.size() - _avail < grow_size) {
+                dynbuf_safe_grow(buf, grow_size);
+            }
+            auto res = buffer_transform(transformer(),
+                                        buf.data(_avail, buf.size() - _avail),
+                                        source(),
+                                        transform_finish);
+            _avail += res.bytes_written;
+            _finished = res.done;
+        }
+    }
+
     void consume(std::size_t n) noexcept {
+        if constexpr (_borrowing) {
+            if (_borrowed != 0) {
+                neo_assert(expects,
+                           n <= _borrowed,
+                           "Attempted to consume more bytes from a buffer_transform_source than "
+                           "are available.",
+                           _borrowed,
+                           n);
+                source().consume(n);
+                _borrowed -= n;
+                return;
+            }
+        }
         neo_assert(
             expects,
             n <= _avail,
@@ -137,4 +278,62 @@ explicit buffer_transform_source(S&&, Tr&&) -> buffer_transform_source<S, Tr>;
 template <typename S, typename Tr, typename B>
 explicit buffer_transform_source(S&&, Tr&&, B&&) -> buffer_transform_source<S, Tr, B>;
 
+/**
+ * A buffer_source that transforms the data of its upstream source where it is,
+ * without an intermediate buffer. The transformer must be in-place safe, and
+ * the upstream source must hand out a single mutable_buffer.
+ *
+ * This overwrites the upstream's memory, so use it only when the untransformed
+ * data is no longer needed (e.g. unmasking a received frame in its own
+ * buffer). buffer_transform_source never modifies its upstream.
+ */
+template <buffer_source Source, buffer_transformer Transform>
+requires buffer_transformer_is_inplace_safe_v<std::remove_cvref_t<Transform>>  //
+    && single_mutable_buffer<decltype(std::declval<Source&>().next(std::size_t()))>
+class buffer_transform_inplace_source {
+    [[no_unique_address]] wrap_ref_member_t<Source>    _source;
+    [[no_unique_address]] wrap_ref_member_t<Transform> _transformer;
+
+    // The number of bytes at the front of the source that are already transformed
+    std::size_t _avail = 0;
+
+public:
+    constexpr buffer_transform_inplace_source() = default;
+    constexpr explicit buffer_transform_inplace_source(Source&& s) noexcept
+        : _source(NEO_FWD(s)) {}
+
+    constexpr explicit buffer_transform_inplace_source(Source&& s, Transform&& tr) noexcept
+        : _source(NEO_FWD(s))
+        , _transformer(NEO_FWD(tr)) {}
+
+    NEO_DECL_UNREF_GETTER(source, _source);
+    NEO_DECL_UNREF_GETTER(transformer, _transformer);
+
+    mutable_buffer next(std::size_t want_size)                                             //
+        noexcept(noexcept(source().next(want_size))
+                 && noexcept(buffer_transform_inplace(transformer(), mutable_buffer())))  //
+    {
+        mutable_buffer buf = source().next(want_size);
+        if (buf.size() > _avail) {
+            auto res = buffer_transform_inplace(transformer(), buf + _avail);
+            _avail += res.bytes_written;
+        }
+        return buf.first((std::min)(_avail, buf.size()));
+    }
+
+    void consume(std::size_t n) noexcept {
+        neo_assert(expects,
+                   n <= _avail,
+                   "Attempted to consume more bytes from a buffer_transform_inplace_source than "
+                   "are available.",
+                   _avail,
+                   n);
+        source().consume(n);
+        _avail -= n;
+    }
+};
+
+template <typename S, typename Tr>
+explicit buffer_transform_inplace_source(S&&, Tr&&) -> buffer_transform_inplace_source<S, Tr>;
+
 }  // namespace neo
@@ -1,26 +1,15 @@
 #include <neo/transform_io.hpp>
 
+#include <neo/bitwise_transform.hpp>
 #include <neo/string_io.hpp>
 #include <neo/test_concept.hpp>
 
 #include <catch2/catch.hpp>
 
-namespace {
+#include <array>
+#include <string>
 
-struct bitnot_transformer {
-    auto operator()(neo::mutable_buffer out, neo::const_buffer in) const noexcept {
-        std::size_t count = 0;
-        while (out && in) {
-            out[0] = ~in[0];
-            out += 1;
-            in += 1;
-            ++count;
-        }
-        return neo::simple_transform_result{count, count, false};
-    }
-};
-
-}  // namespace
+using neo::bitnot_transformer;
 
 NEO_TEST_CONCEPT(neo::buffer_transform_result<neo::simple_transform_result>);
 NEO_TEST_CONCEPT(neo::buffer_transformer<bitnot_transformer>);
@@ -28,11 +17,22 @@ NEO_TEST_CONCEPT(neo::buffer_transformer<bitnot_transformer>);
 NEO_TEST_CONCEPT(
     neo::buffer_sink<neo::buffer_transform_sink<neo::proto_buffer_sink, bitnot_transformer>>);
 
+namespace {
+
+/// A bitnot that is not marked in-place safe, so data goes through the staging buffers
+struct staged_bitnot {
+    neo::simple_transform_result operator()(neo::mutable_buffer out, neo::const_buffer in) {
+        return bitnot_transformer{}(out, in);
+    }
+};
+
+}  // namespace
+
 TEST_CASE("Create a simple sink") {
     // Create a destination
     neo::string_dynbuf_io out;
-    // A sink that transforms by passing data through a bitnot_transformer
-    neo::buffer_transform_sink bitnot_sink{out, bitnot_transformer()};
+    // A sink that transforms by passing data through a bitnot
+    neo::buffer_transform_sink bitnot_sink{out, staged_bitnot()};
     // The string we are testing:
     const std::string original = "Hello, world!";
 
@@ -55,7 +55,7 @@ TEST_CASE("Source with a fixed buffer") {
     std::string    str = "I am a string";
     neo::dynbuf_io input{str};
 
-    neo::buffer_transform_source bitnot_source{input, bitnot_transformer{}};
+    neo::buffer_transform_source bitnot_source{input, staged_bitnot{}};
 
     neo::string_dynbuf_io out;
     neo::buffer_copy(out, bitnot_source);
@@ -74,3 +74,168 @@ TEST_CASE("Source with a fixed buffer") {
     CHECK(out.string()[11] == ~'n');
     CHECK(out.string()[12] == ~'g');
 }
+
+namespace {
+
+/// An in-place safe bitnot that records whether it was handed aliased buffers
+struct aliasing_probe {
+    int* n_aliased;
+    int* n_calls;
+
+    neo::simple_transform_result operator()(neo::mutable_buffer out, neo::const_buffer in) {
+        ++*n_calls;
+        if (out.data() == in.data()) {
+            ++*n_aliased;
+        }
+        return bitnot_transformer{}(out, in);
+    }
+};
+
+}  // namespace
+
+template <>
+constexpr bool neo::buffer_transformer_is_inplace_safe_v<aliasing_probe> = true;
+
+TEST_CASE("Sink transforms in place") {
+    int                   n_aliased = 0;
+    int                   n_calls   = 0;
+    neo::string_dynbuf_io out;
+
+    neo::buffer_transform_sink sink{out, aliasing_probe{&n_aliased, &n_calls}};
+    const std::string          original(5000, 'a');
+    neo::buffer_copy(sink, neo::as_buffer(original));
+    CHECK(out.read_area_view() == std::string(5000, ~'a'));
+    CHECK(n_calls > 0);
+    CHECK(n_aliased == n_calls);
+    // The sink's staging buffer was never used
+    CHECK(sink.buffer().size() == 0);
+}
+
+TEST_CASE("A transform source never modifies its upstream") {
+    std::string str = "I am a string";
+
+    neo::buffers_consumer<neo::mutable_buffer> input{neo::mutable_buffer(neo::as_buffer(str))};
+    neo::buffer_transform_source               source{input, bitnot_transformer{}};
+
+    neo::string_dynbuf_io out;
+    neo::buffer_copy(out, source);
+    CHECK(str == "I am a string");
+    CHECK(out.read_area_view().size() == str.size());
+    CHECK(out.read_area_view()[0] == ~'I');
+}
+
+TEST_CASE("Source transforms in place") {
+    int         n_aliased = 0;
+    int         n_calls   = 0;
+    std::string str       = "I am a string";
+
+    neo::buffers_consumer<neo::mutable_buffer> input{neo::mutable_buffer(neo::as_buffer(str))};
+    neo::buffer_transform_inplace_source       source{input,
+                                                aliasing_probe{&n_aliased, &n_calls}};
+
+    // Ask for the same data twice, which must not transform it twice
+    auto part = source.next(4);
+    CHECK(part.size() == 4);
+    part = source.next(6);
+    CHECK(part.size() == 6);
+    source.consume(2);
+
+    neo::string_dynbuf_io out;
+    neo::buffer_copy(out, source);
+    CHECK(n_calls > 0);
+    CHECK(n_aliased == n_calls);
+    // The source's storage now holds the transformed data
+    CHECK(str[0] == ~'I');
+    CHECK(str[12] == ~'g');
+    CHECK(out.read_area_view() == std::string_view(str).substr(2));
+}
+
+TEST_CASE("Transform a range of buffers in place") {
+    std::string a = "first buffer, ";
+    std::string b = "second, ";
+    std::string c = "and the third buffer";
+
+    const std::array<std::byte, 4> key = {std::byte(1), std::byte(2), std::byte(3), std::byte(4)};
+    neo::string_dynbuf_io          expect;
+    neo::xor_mask_transformer      copy_tr{key};
+    neo::buffer_transform(copy_tr, expect, neo::as_buffer(a + b + c));
+
+    std::array<neo::mutable_buffer, 3> bufs = {neo::mutable_buffer(neo::as_buffer(a)),
+                                               neo::mutable_buffer(neo::as_buffer(b)),
+                                               neo::mutable_buffer(neo::as_buffer(c))};
+    neo::xor_mask_transformer          tr{key};
+    auto                               res = neo::buffer_transform_inplace(tr, bufs);
+    CHECK(res.bytes_read == a.size() + b.size() + c.size());
+    CHECK(res.bytes_written == res.bytes_read);
+    CHECK(a + b + c == expect.read_area_view());
+    CHECK(tr.phase() == (a.size() + b.size() + c.size()) % 4);
+}
+
+static_assert(neo::buffer_transformer_is_inplace_safe_v<neo::bitnot_transformer>);
+static_assert(neo::buffer_transformer_is_inplace_safe_v<neo::xor_mask_transformer>);
+static_assert(!neo::buffer_transformer_is_inplace_safe_v<neo::byteswap32_transformer>);
+
+namespace {
+
+/// Upper-cases ASCII letters. Runs of data without lowercase letters are
+/// passed through.
+struct upcase_transformer {
+    int n_passthrough = 0;
+
+    neo::simple_transform_result operator()(neo::mutable_buffer out, neo::const_buffer in) {
+        const auto n = (std::min)(out.size(), in.size());
+        for (std::size_t i = 0; i < n; ++i) {
+            auto c = static_cast<char>(in[i]);
+            if (c >= 'a' && c <= 'z') {
+                c = static_cast<char>(c - 'a' + 'A');
+            }
+            out[i] = std::byte(c);
+        }
+        return {n, n, false};
+    }
+
+    std::size_t passthrough(neo::const_buffer in) {
+        std::size_t n = 0;
+        while (n < in.size() && !(in[n] >= std::byte('a') && in[n] <= std::byte('z'))) {
+            ++n;
+        }
+        if (n) {
+            ++n_passthrough;
+        }
+        return n;
+    }
+};
+
+}  // namespace
+
+NEO_TEST_CONCEPT(neo::buffer_passthrough_transformer<upcase_transformer>);
+NEO_TEST_CONCEPT(neo::buffer_passthrough_transformer<neo::buffer_copy_transformer<>>);
+
+TEST_CASE("Source borrows data that passes through") {
+    const std::string           str = "NOTHING TO CHANGE HERE";
+    neo::buffers_consumer       input{neo::as_buffer(str)};
+    neo::buffer_transform_source source{input, neo::buffer_copy_transformer<>{}};
+
+    auto part = source.next(7);
+    CHECK(part.size() == 7);
+    // The data is a view of the original string, not a copy
+    CHECK(part.data() == neo::byte_pointer(str.data()));
+    source.consume(3);
+    part = source.next(100);
+    CHECK(part.data() == neo::byte_pointer(str.data() + 3));
+
+    neo::string_dynbuf_io out;
+    neo::buffer_copy(out, source);
+    CHECK(out.read_area_view() == str.substr(3));
+}
+
+TEST_CASE("Source mixes borrowed and transformed data") {
+    const std::string            str = "ALREADY UPPER, then lower, THEN UPPER AGAIN";
+    neo::buffers_consumer        input{neo::as_buffer(str)};
+    neo::buffer_transform_source source{input, upcase_transformer{}};
+
+    neo::string_dynbuf_io out;
+    neo::buffer_copy(out, source);
+    CHECK(out.read_area_view() == "ALREADY UPPER, THEN LOWER, THEN UPPER AGAIN");
+    CHECK(source.transformer().n_passthrough > 0);
+}
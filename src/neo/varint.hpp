@@ -0,0 +1,613 @@
+#pragma once
+
+#include <neo/const_buffer.hpp>
+#include <neo/mutable_buffer.hpp>
+
+#include <neo/assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+#if defined(__SSSE3__)
+#include <immintrin.h>
+#define NEO_VARINT_HAS_SSSE3 1
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define NEO_VARINT_HAS_SSE2 1
+#endif
+
+namespace neo {
+
+/**
+ * The result of a varint encoder. The value has been completely written once
+ * `done()`, and otherwise the encoder must be called again with more room and
+ * the same value.
+ */
+struct varint_encode_result {
+    std::size_t bytes_written = 0;
+    bool        complete      = false;
+
+    constexpr bool done() const noexcept { return complete; }
+};
+
+/**
+ * The result of a varint decoder. If the input ended partway through a value,
+ * the decoder holds on to the partial value, and neither `has_value()` nor
+ * `has_error()` is set.
+ */
+template <typename T>
+struct varint_decode_result {
+    std::size_t bytes_read = 0;
+    T           decoded{};
+    bool        complete = false;
+    /// The input was not a valid encoding
+    bool error = false;
+
+    constexpr T&       value() noexcept { return decoded; }
+    constexpr const T& value() const noexcept { return decoded; }
+    constexpr bool     has_value() const noexcept { return complete; }
+    constexpr bool     has_error() const noexcept { return error; }
+};
+
+/**
+ * The result of a `decode_many()` call on a varint decoder.
+ */
+struct varint_decode_many_result {
+    /// The number of bytes of input that were consumed
+    std::size_t bytes_read = 0;
+    /// The number of values that were written to the output
+    std::size_t count = 0;
+    /// The input was not a valid encoding. Decoding stopped at the bad value.
+    bool error = false;
+};
+
+/// The largest number of bytes in the LEB128 encoding of a `T`
+template <std::unsigned_integral T>
+constexpr std::size_t leb128_max_size_v = (std::numeric_limits<T>::digits + 6) / 7;
+
+/// Get the number of bytes in the LEB128 encoding of `v`
+template <std::unsigned_integral T>
+constexpr std::size_t leb128_size(T v) noexcept {
+    std::size_t n = 1;
+    while (v >= 0x80) {
+        v >>= 7;
+        ++n;
+    }
+    return n;
+}
+
+/// Map a signed integer to an unsigned one such that small magnitudes map to small values
+template <std::signed_integral T>
+constexpr std::make_unsigned_t<T> zigzag_encode(T v) noexcept {
+    using U = std::make_unsigned_t<T>;
+    return static_cast<U>(static_cast<U>(static_cast<U>(v) << 1)
+                          ^ static_cast<U>(v >> (std::numeric_limits<U>::digits - 1)));
+}
+
+/// The inverse of zigzag_encode()
+template <std::unsigned_integral U>
+constexpr std::make_signed_t<U> zigzag_decode(U v) noexcept {
+    return static_cast<std::make_signed_t<U>>(static_cast<U>(v >> 1) ^ static_cast<U>(-(v & 1u)));
+}
+
+namespace detail {
+
+template <std::unsigned_integral T>
+constexpr std::size_t leb128_write(std::byte* out, T v) noexcept {
+    std::size_t n = 0;
+    while (v >= 0x80) {
+        out[n++] = std::byte(static_cast<unsigned char>(v | 0x80));
+        v >>= 7;
+    }
+    out[n++] = std::byte(static_cast<unsigned char>(v));
+    return n;
+}
+
+}  // namespace detail
+
+/**
+ * A buffer_encoder that writes unsigned integers in the LEB128 format: seven
+ * bits per byte, least-significant group first, with the high bit of each byte
+ * set if more bytes follow.
+ *
+ * If the output is too small, the encoder remembers how much of the value was
+ * written, and continues from there when called again with the same value.
+ */
+template <std::unsigned_integral T = std::uint64_t>
+class leb128_encoder {
+    std::size_t _off = 0;
+
+public:
+    constexpr varint_encode_result operator()(mutable_buffer out, T value) noexcept {
+        if (_off == 0 && out.size() >= leb128_max_size_v<T>) {
+            return {detail::leb128_write(out.data(), value), true};
+        }
+        std::array<std::byte, leb128_max_size_v<T>> tmp{};
+        const auto size = detail::leb128_write(tmp.data(), value);
+        const auto n    = (std::min)(size - _off, out.size());
+        std::copy_n(tmp.data() + _off, n, out.data());
+        _off += n;
+        if (_off != size) {
+            return {n, false};
+        }
+        _off = 0;
+        return {n, true};
+    }
+};
+
+/**
+ * A buffer_decoder for unsigned LEB128 integers. A value may be split across
+ * any number of calls. An encoding that is longer than `leb128_max_size_v<T>`,
+ * or whose value does not fit in a `T`, is an error.
+ */
+template <std::unsigned_integral T = std::uint64_t>
+class leb128_decoder {
+    T        _value = 0;
+    unsigned _shift = 0;
+
+    enum class step { more, value, error };
+
+    constexpr step _feed(std::byte b) noexcept {
+        constexpr unsigned digits = std::numeric_limits<T>::digits;
+        const auto         byte   = static_cast<unsigned char>(b);
+        const T            bits   = static_cast<T>(byte & 0x7f);
+        if (_shift >= digits || (digits - _shift < 7 && (bits >> (digits - _shift)) != 0)) {
+            _value = 0;
+            _shift = 0;
+            return step::error;
+        }
+        _value = static_cast<T>(_value | static_cast<T>(bits << _shift));
+        if ((byte & 0x80) == 0) {
+            return step::value;
+        }
+        _shift += 7;
+        return step::more;
+    }
+
+    constexpr T _take() noexcept {
+        const auto v = _value;
+        _value       = 0;
+        _shift       = 0;
+        return v;
+    }
+
+public:
+    constexpr varint_decode_result<T> operator()(const_buffer in) noexcept {
+        varint_decode_result<T> res;
+        while (res.bytes_read < in.size()) {
+            const auto st = _feed(in[res.bytes_read++]);
+            if (st == step::value) {
+                res.decoded  = _take();
+                res.complete = true;
+                break;
+            } else if (st == step::error) {
+                res.error = true;
+                break;
+            }
+        }
+        return res;
+    }
+
+    /**
+     * Decode as many values from `in` as fit in `out`. A value that is cut off
+     * at the end of `in` is held by the decoder and completed by the next call.
+     * Runs of single-byte values are decoded sixteen at a time where SSE2 is
+     * available.
+     */
+    varint_decode_many_result decode_many(const_buffer in, std::span<T> out) noexcept {
+        varint_decode_many_result res;
+        const std::byte*          p   = in.data();
+        const std::byte* const    end = p + in.size();
+        while (res.count < out.size() && p != end) {
+#if NEO_VARINT_HAS_SSE2
+            if (_shift == 0 && end - p >= 16) {
+                const auto v    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                const auto mask = static_cast<unsigned>(_mm_movemask_epi8(v));
+                // Every byte before the first continuation bit is a whole value
+                const auto n_single = (std::min)(mask == 0 ? std::size_t(16)
+                                                           : std::size_t(std::countr_zero(mask)),
+                                                 out.size() - res.count);
+                for (std::size_t i = 0; i < n_single; ++i) {
+                    out[res.count + i] = static_cast<T>(p[i]);
+                }
+                p += n_single;
+                res.count += n_single;
+                if (n_single != 0) {
+                    continue;
+                }
+            }
+#endif
+            // Decode a single value, which may finish one from a prior call
+            step st = step::more;
+            while (p != end && st == step::more) {
+                st = _feed(*p++);
+            }
+            if (st == step::value) {
+                out[res.count++] = _take();
+            } else if (st == step::error) {
+                res.error = true;
+                break;
+            }
+        }
+        res.bytes_read = static_cast<std::size_t>(p - in.data());
+        return res;
+    }
+};
+
+/**
+ * A buffer_encoder for signed integers, which are zigzag-mapped and written in
+ * LEB128, so that values near zero of either sign are short.
+ */
+template <std::signed_integral T = std::int64_t>
+class zigzag_encoder {
+    leb128_encoder<std::make_unsigned_t<T>> _leb;
+
+public:
+    constexpr varint_encode_result operator()(mutable_buffer out, T value) noexcept {
+        return _leb(out, zigzag_encode(value));
+    }
+};
+
+/**
+ * The buffer_decoder for zigzag_encoder.
+ */
+template <std::signed_integral T = std::int64_t>
+class zigzag_decoder {
+    using unsigned_type = std::make_unsigned_t<T>;
+    leb128_decoder<unsigned_type> _leb;
+
+public:
+    constexpr varint_decode_result<T> operator()(const_buffer in) noexcept {
+        auto res = _leb(in);
+        return {res.bytes_read, zigzag_decode(res.decoded), res.complete, res.error};
+    }
+
+    /// Decode as many values from `in` as fit in `out`. See leb128_decoder::decode_many()
+    varint_decode_many_result decode_many(const_buffer in, std::span<T> out) noexcept {
+        // Signed and unsigned integers of the same width may alias each other
+        auto res = _leb.decode_many(in,
+                                    std::span<unsigned_type>(reinterpret_cast<unsigned_type*>(
+                                                                 out.data()),
+                                                             out.size()));
+        for (std::size_t i = 0; i < res.count; ++i) {
+            out[i] = zigzag_decode(static_cast<unsigned_type>(out[i]));
+        }
+        return res;
+    }
+};
+
+/// A group of four values, the unit of the group varint format
+using group_varint_group = std::array<std::uint32_t, 4>;
+
+/// The largest size of an encoded group varint group
+inline constexpr std::size_t group_varint_max_group_size = 17;
+
+namespace detail {
+
+constexpr std::size_t svb_value_size(std::uint32_t v) noexcept {
+    return v < (1u << 8) ? 1 : v < (1u << 16) ? 2 : v < (1u << 24) ? 3 : 4;
+}
+
+/// The number of data bytes of the first `n` values described by a control byte
+constexpr std::size_t svb_data_size(std::byte control, unsigned n = 4) noexcept {
+    const auto  c    = static_cast<unsigned>(control);
+    std::size_t size = 0;
+    for (unsigned i = 0; i < n; ++i) {
+        size += ((c >> (2 * i)) & 3) + 1;
+    }
+    return size;
+}
+
+/**
+ * Write the data bytes of the first `n` values of `g` to `data`, and return
+ * the control byte that describes them.
+ */
+constexpr std::byte svb_write_values(std::byte*           data,
+                                     const std::uint32_t* g,
+                                     unsigned             n,
+                                     std::size_t&         n_written) noexcept {
+    unsigned control = 0;
+    n_written        = 0;
+    for (unsigned i = 0; i < n; ++i) {
+        const auto size = svb_value_size(g[i]);
+        control |= static_cast<unsigned>(size - 1) << (2 * i);
+        for (std::size_t b = 0; b < size; ++b) {
+            data[n_written++] = std::byte(static_cast<unsigned char>(g[i] >> (8 * b)));
+        }
+    }
+    return std::byte(static_cast<unsigned char>(control));
+}
+
+/// Read the first `n` values described by `control` from `data` into `out`
+constexpr void
+svb_read_values(std::byte control, const std::byte* data, std::uint32_t* out, unsigned n) noexcept {
+    const auto c = static_cast<unsigned>(control);
+    for (unsigned i = 0; i < n; ++i) {
+        const auto    size = ((c >> (2 * i)) & 3) + 1;
+        std::uint32_t v    = 0;
+        for (unsigned b = 0; b < size; ++b) {
+            v |= static_cast<std::uint32_t>(*data++) << (8 * b);
+        }
+        out[i] = v;
+    }
+}
+
+constexpr std::size_t group_varint_size(std::byte control) noexcept {
+    return 1 + svb_data_size(control);
+}
+
+constexpr std::size_t group_varint_write(std::byte* out, const group_varint_group& g) noexcept {
+    std::size_t n = 0;
+    out[0]        = svb_write_values(out + 1, g.data(), 4, n);
+    return n + 1;
+}
+
+constexpr group_varint_group group_varint_read(const std::byte* in) noexcept {
+    group_varint_group g{};
+    svb_read_values(in[0], in + 1, g.data(), 4);
+    return g;
+}
+
+/**
+ * For each control byte, the pshufb mask that moves the data bytes of a group
+ * into four little-endian 32-bit lanes. Bytes with the high bit set are zeroed.
+ */
+constexpr auto make_svb_shuffle_masks() noexcept {
+    std::array<std::array<std::uint8_t, 16>, 256> masks{};
+    for (unsigned control = 0; control < 256; ++control) {
+        unsigned pos = 0;
+        for (unsigned i = 0; i < 4; ++i) {
+            const auto size = ((control >> (2 * i)) & 3) + 1;
+            for (unsigned b = 0; b < 4; ++b) {
+                masks[control][4 * i + b] = b < size ? static_cast<std::uint8_t>(pos++) : 0x80;
+            }
+        }
+    }
+    return masks;
+}
+
+inline constexpr auto svb_shuffle_masks = make_svb_shuffle_masks();
+
+/**
+ * Unpack the four values described by `control` from `data` into `out`.
+ * `data` must be followed by at least sixteen readable bytes when SSSE3 is
+ * available.
+ */
+inline void
+svb_unpack_group(std::byte control, const std::byte* data, std::uint32_t* out) noexcept {
+#if NEO_VARINT_HAS_SSSE3
+    const auto& mask_bytes = svb_shuffle_masks[static_cast<unsigned>(control)];
+    const auto  v          = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    const auto  mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask_bytes.data()));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(v, mask));
+#else
+    svb_read_values(control, data, out, 4);
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * A buffer_encoder for groups of four 32-bit integers in the group varint
+ * format: a control byte holding the byte length (less one) of each value in
+ * two bits, starting from the low bits, followed by the values in that many
+ * little-endian bytes. A group is between 5 and 17 bytes.
+ *
+ * Each control byte sits directly before its data, so the format can be
+ * written and read as a single stream. This is *not* the Stream VByte layout,
+ * which keeps all control bytes apart from all data bytes; for that, see
+ * stream_vbyte_encode() and stream_vbyte_decode_many().
+ *
+ * If the output is too small, the encoder holds on to the encoded group and
+ * writes the rest when called again with the same group.
+ */
+class group_varint_encoder {
+    std::array<std::byte, group_varint_max_group_size> _staged{};
+    std::size_t                                        _size = 0;
+    std::size_t                                        _off  = 0;
+
+public:
+    constexpr varint_encode_result operator()(mutable_buffer            out,
+                                              const group_varint_group& group) noexcept {
+        if (_off == 0) {
+            if (out.size() >= group_varint_max_group_size) {
+                return {detail::group_varint_write(out.data(), group), true};
+            }
+            _size = detail::group_varint_write(_staged.data(), group);
+        }
+        const auto n = (std::min)(_size - _off, out.size());
+        std::copy_n(_staged.data() + _off, n, out.data());
+        _off += n;
+        if (_off != _size) {
+            return {n, false};
+        }
+        _off = 0;
+        return {n, true};
+    }
+};
+
+/**
+ * The buffer_decoder for group_varint_encoder. A group may be split across any
+ * number of calls.
+ */
+class group_varint_decoder {
+    std::array<std::byte, group_varint_max_group_size> _staged{};
+    std::size_t                                        _have = 0;
+
+public:
+    constexpr varint_decode_result<group_varint_group> operator()(const_buffer in) noexcept {
+        varint_decode_result<group_varint_group> res;
+        if (_have == 0 && !in.empty() && in.size() >= detail::group_varint_size(in[0])) {
+            res.decoded    = detail::group_varint_read(in.data());
+            res.bytes_read = detail::group_varint_size(in[0]);
+            res.complete   = true;
+            return res;
+        }
+        while (!in.empty()) {
+            const auto need = _have == 0 ? std::size_t(1) : detail::group_varint_size(_staged[0]);
+            const auto n    = (std::min)(need - _have, in.size());
+            std::copy_n(in.data(), n, _staged.data() + _have);
+            _have += n;
+            in += n;
+            res.bytes_read += n;
+            if (_have > 1 && _have == detail::group_varint_size(_staged[0])) {
+                res.decoded  = detail::group_varint_read(_staged.data());
+                res.complete = true;
+                _have        = 0;
+                break;
+            }
+        }
+        return res;
+    }
+
+    /**
+     * Decode as many whole groups from `in` as fit in `out`, writing four values
+     * for each. A group that is cut off at the end of `in` is held by the
+     * decoder and completed by the next call. Where SSSE3 is available, groups
+     * that are followed by enough input are unpacked with a single shuffle.
+     */
+    varint_decode_many_result decode_many(const_buffer in, std::span<std::uint32_t> out) noexcept {
+        varint_decode_many_result res;
+        if (_have != 0) {
+            // Finish the group that was cut off by the prior call
+            if (out.size() < 4) {
+                return res;
+            }
+            const auto part = (*this)(in);
+            in += part.bytes_read;
+            res.bytes_read += part.bytes_read;
+            if (!part.complete) {
+                return res;
+            }
+            std::copy_n(part.decoded.begin(), 4, out.begin());
+            res.count = 4;
+        }
+        const std::byte*       p   = in.data();
+        const std::byte* const end = p + in.size();
+        while (out.size() - res.count >= 4 && p != end) {
+            const auto size = detail::group_varint_size(*p);
+            if (static_cast<std::size_t>(end - p) < size) {
+                // Hold on to the partial group
+                p += (*this)(const_buffer(p, static_cast<std::size_t>(end - p))).bytes_read;
+                break;
+            }
+            auto dest = out.data() + res.count;
+            // The shuffle reads sixteen data bytes, regardless of the group's size
+            if (end - p >= 17) {
+                detail::svb_unpack_group(*p, p + 1, dest);
+            } else {
+                detail::svb_read_values(*p, p + 1, dest, 4);
+            }
+            p += size;
+            res.count += 4;
+        }
+        res.bytes_read += static_cast<std::size_t>(p - in.data());
+        return res;
+    }
+};
+
+/// The number of control bytes of `count` values in the Stream VByte layout
+constexpr std::size_t stream_vbyte_control_size(std::size_t count) noexcept {
+    return (count + 3) / 4;
+}
+
+/// The largest number of data bytes of `count` values in the Stream VByte layout
+constexpr std::size_t stream_vbyte_max_data_size(std::size_t count) noexcept {
+    return count * 4;
+}
+
+/**
+ * The result of stream_vbyte_encode() and stream_vbyte_decode_many().
+ */
+struct stream_vbyte_result {
+    /// The number of control bytes that were written or read
+    std::size_t control_bytes = 0;
+    /// The number of data bytes that were written or read
+    std::size_t data_bytes = 0;
+    /// The number of values that were encoded or decoded
+    std::size_t count = 0;
+};
+
+/**
+ * Encode `values` in the Stream VByte layout: one control byte for every four
+ * values is written to `control`, and the values' data bytes to `data`. Each
+ * control byte holds the byte length (less one) of four values in two bits,
+ * starting from the low bits, and each value is written in that many
+ * little-endian bytes. The unused bits of a final partial group are zero.
+ *
+ * `control` must hold at least `stream_vbyte_control_size(values.size())`
+ * bytes, and `data` at least `stream_vbyte_max_data_size(values.size())`.
+ */
+constexpr stream_vbyte_result stream_vbyte_encode(std::span<const std::uint32_t> values,
+                                                  mutable_buffer                 control,
+                                                  mutable_buffer data) noexcept {
+    neo_assert(expects,
+               control.size() >= stream_vbyte_control_size(values.size())
+                   && data.size() >= stream_vbyte_max_data_size(values.size()),
+               "Not enough room to Stream VByte-encode the given values",
+               values.size(),
+               control.size(),
+               data.size());
+    stream_vbyte_result res;
+    for (std::size_t i = 0; i < values.size(); i += 4) {
+        const auto  n = static_cast<unsigned>((std::min)(values.size() - i, std::size_t(4)));
+        std::size_t n_written = 0;
+        const auto  ctl       = detail::svb_write_values(data.data() + res.data_bytes,
+                                                         values.data() + i,
+                                                         n,
+                                                         n_written);
+        control[res.control_bytes++] = ctl;
+        res.data_bytes += n_written;
+    }
+    res.count = values.size();
+    return res;
+}
+
+/**
+ * Decode values in the Stream VByte layout, with control bytes in `control`
+ * and data bytes in `data`, until `out` is full or either input runs out.
+ *
+ * Only whole groups of four are decoded, except that when `out` has room for
+ * fewer than four more values, that many values are decoded from the next
+ * group (as for the end of a list whose length is not a multiple of four). The
+ * result tells how far into each input to resume. Where SSSE3 is available,
+ * groups that are followed by enough data are unpacked with a single shuffle.
+ */
+inline stream_vbyte_result stream_vbyte_decode_many(const_buffer             control,
+                                                    const_buffer             data,
+                                                    std::span<std::uint32_t> out) noexcept {
+    stream_vbyte_result    res;
+    const std::byte*       p   = data.data();
+    const std::byte* const end = p + data.size();
+    while (res.control_bytes != control.size() && res.count != out.size()) {
+        const auto ctl  = control[res.control_bytes];
+        const auto n    = static_cast<unsigned>((std::min)(out.size() - res.count, std::size_t(4)));
+        const auto size = detail::svb_data_size(ctl, n);
+        if (static_cast<std::size_t>(end - p) < size) {
+            break;
+        }
+        auto dest = out.data() + res.count;
+        // The shuffle reads sixteen data bytes, regardless of the group's size
+        if (n == 4 && end - p >= 16) {
+            detail::svb_unpack_group(ctl, p, dest);
+        } else {
+            detail::svb_read_values(ctl, p, dest, n);
+        }
+        p += size;
+        res.count += n;
+        ++res.control_bytes;
+    }
+    res.data_bytes = static_cast<std::size_t>(p - data.data());
+    return res;
+}
+
+}  // namespace neo
@@ -0,0 +1,285 @@
+#include <neo/varint.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/buffer_algorithm/decode.hpp>
+#include <neo/buffer_algorithm/encode.hpp>
+#include <neo/string_io.hpp>
+#include <neo/test_concept.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+NEO_TEST_CONCEPT(neo::buffer_encoder<neo::leb128_encoder<>, std::uint64_t>);
+NEO_TEST_CONCEPT(neo::buffer_decoder<neo::leb128_decoder<>>);
+NEO_TEST_CONCEPT(neo::buffer_encoder<neo::zigzag_encoder<>, std::int64_t>);
+NEO_TEST_CONCEPT(neo::buffer_decoder<neo::zigzag_decoder<>>);
+NEO_TEST_CONCEPT(neo::buffer_encoder<neo::group_varint_encoder, neo::group_varint_group>);
+NEO_TEST_CONCEPT(neo::buffer_decoder<neo::group_varint_decoder>);
+
+static_assert(neo::leb128_max_size_v<std::uint32_t> == 5);
+static_assert(neo::leb128_max_size_v<std::uint64_t> == 10);
+static_assert(neo::leb128_size(300u) == 2);
+static_assert(neo::zigzag_encode(0) == 0);
+static_assert(neo::zigzag_encode(-1) == 1);
+static_assert(neo::zigzag_encode(1) == 2);
+static_assert(neo::zigzag_encode(std::numeric_limits<std::int64_t>::min())
+              == std::numeric_limits<std::uint64_t>::max());
+static_assert(neo::zigzag_decode(3u) == -2);
+static_assert(neo::stream_vbyte_control_size(9) == 3);
+
+namespace {
+
+template <typename Encoder, typename T>
+std::string encode_all(const std::vector<T>& values) {
+    neo::string_dynbuf_io out;
+    for (const auto& v : values) {
+        neo::buffer_encode(Encoder(), out, v);
+    }
+    return std::string(out.read_area_view());
+}
+
+std::vector<std::uint64_t> posting_deltas() {
+    // Mostly small values, with the occasional large one
+    std::vector<std::uint64_t> values;
+    std::uint64_t              x = 7;
+    for (int i = 0; i < 5000; ++i) {
+        x = x * 6364136223846793005u + 1442695040888963407u;
+        values.push_back(i % 9 == 0 ? x >> (x % 64) : (x >> 58));
+    }
+    return values;
+}
+
+}  // namespace
+
+TEST_CASE("Encode and decode LEB128") {
+    CHECK(encode_all<neo::leb128_encoder<>>(std::vector<std::uint64_t>{300})
+          == std::string("\xac\x02"));
+    CHECK(encode_all<neo::leb128_encoder<>>(std::vector<std::uint64_t>{0})
+          == std::string(1, '\0'));
+
+    std::vector<std::uint64_t> values = {0, 1, 127, 128, 300, 1ull << 32, ~0ull};
+    auto                       bytes  = encode_all<neo::leb128_encoder<>>(values);
+    CHECK(bytes.size() == 1 + 1 + 1 + 2 + 2 + 5 + 10);
+
+    neo::leb128_decoder<>      dec;
+    std::vector<std::uint64_t> got;
+    auto                       in = neo::as_buffer(bytes);
+    while (!in.empty()) {
+        auto res = dec(in);
+        REQUIRE(res.has_value());
+        got.push_back(res.value());
+        in += res.bytes_read;
+    }
+    CHECK(got == values);
+}
+
+TEST_CASE("LEB128 values are resumable across segments") {
+    const std::uint64_t   value = 0x0123'4567'89ab'cdefu;
+    neo::leb128_encoder<> enc;
+    std::string           bytes;
+    while (true) {
+        std::byte one{};
+        auto      res = enc(neo::mutable_buffer(&one, 1), value);
+        bytes.push_back(static_cast<char>(one));
+        CHECK(res.bytes_written == 1);
+        if (res.done()) {
+            break;
+        }
+    }
+    CHECK(bytes.size() == neo::leb128_size(value));
+
+    // Feed one byte at a time
+    neo::leb128_decoder<> dec;
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        auto res = dec((neo::as_buffer(bytes) + i).first(1));
+        CHECK(res.bytes_read == 1);
+        CHECK(res.has_value() == (i + 1 == bytes.size()));
+        if (res.has_value()) {
+            CHECK(res.value() == value);
+        }
+    }
+}
+
+TEST_CASE("Reject malformed LEB128") {
+    neo::leb128_decoder<std::uint32_t> dec;
+    // Too large for 32 bits
+    auto res = dec(neo::as_buffer(std::string("\xff\xff\xff\xff\x10")));
+    CHECK(res.has_error());
+    CHECK(res.bytes_read == 5);
+    // The largest 32-bit value is fine
+    res = dec(neo::as_buffer(std::string("\xff\xff\xff\xff\x0f")));
+    REQUIRE(res.has_value());
+    CHECK(res.value() == 0xffff'ffffu);
+    // Too long
+    res = dec(neo::as_buffer(std::string("\x80\x80\x80\x80\x80\x00", 6)));
+    CHECK(res.has_error());
+}
+
+TEST_CASE("Encode and decode zigzag varints") {
+    std::vector<std::int64_t> values = {0, -1, 1, -64, 63, -65, 64, 1'000'000'000'000, -7};
+    values.push_back(std::numeric_limits<std::int64_t>::min());
+    values.push_back(std::numeric_limits<std::int64_t>::max());
+    auto bytes = encode_all<neo::zigzag_encoder<>>(values);
+    // Values in [-64, 63] take one byte
+    CHECK(bytes.substr(0, 5) == std::string("\x00\x01\x02\x7f\x7e", 5));
+
+    std::vector<std::int64_t> got(values.size());
+    neo::zigzag_decoder<>     dec;
+    auto                      res = dec.decode_many(neo::as_buffer(bytes), got);
+    CHECK(res.count == values.size());
+    CHECK(res.bytes_read == bytes.size());
+    CHECK(got == values);
+
+    auto one = neo::buffer_decode(neo::zigzag_decoder<>(), neo::as_buffer(bytes) + 1);
+    REQUIRE(one.has_value());
+    CHECK(one.value() == -1);
+}
+
+TEST_CASE("Batch-decode LEB128 across segments") {
+    const auto values = posting_deltas();
+    const auto bytes  = encode_all<neo::leb128_encoder<>>(values);
+
+    // Split at every kind of position, including partway through a value
+    const std::size_t split = GENERATE(0u, 1u, 17u, 1000u, 4001u);
+    REQUIRE(split <= bytes.size());
+    neo::leb128_decoder<>      dec;
+    std::vector<std::uint64_t> got(values.size());
+    auto first = dec.decode_many(neo::as_buffer(bytes, split), got);
+    CHECK(first.bytes_read == split);
+    auto second = dec.decode_many(neo::as_buffer(bytes) + split,
+                                  std::span(got).subspan(first.count));
+    CHECK_FALSE(second.error);
+    CHECK(first.count + second.count == values.size());
+    CHECK(second.bytes_read == bytes.size() - split);
+    CHECK(got == values);
+
+    // Stop when the output is full
+    std::vector<std::uint64_t> few(10);
+    neo::leb128_decoder<>      dec2;
+    auto                       res = dec2.decode_many(neo::as_buffer(bytes), few);
+    CHECK(res.count == 10);
+    CHECK(std::equal(few.begin(), few.end(), values.begin()));
+}
+
+TEST_CASE("Encode and decode group varint groups") {
+    neo::group_varint_group group = {1, 256, 65536, 1u << 24};
+    neo::string_dynbuf_io   out;
+    auto                    res = neo::buffer_encode(neo::group_varint_encoder(), out, group);
+    CHECK(res.bytes_written == 11);
+    // The control byte sits directly before its data
+    CHECK(out.read_area_view()
+          == std::string("\xe4"
+                         "\x01"
+                         "\x00\x01"
+                         "\x00\x00\x01"
+                         "\x00\x00\x00\x01",
+                         11));
+
+    auto dec = neo::buffer_decode(neo::group_varint_decoder(),
+                                  neo::as_buffer(out.read_area_view()));
+    REQUIRE(dec.has_value());
+    CHECK(dec.value() == group);
+
+    // Resume partway through a group
+    neo::group_varint_decoder partial;
+    auto                      bytes = std::string(out.read_area_view());
+    auto                      r1    = partial(neo::as_buffer(bytes, 3));
+    CHECK_FALSE(r1.has_value());
+    auto r2 = partial(neo::as_buffer(bytes) + 3);
+    REQUIRE(r2.has_value());
+    CHECK(r2.bytes_read == 8);
+    CHECK(r2.value() == group);
+}
+
+TEST_CASE("Batch-decode group varint across segments") {
+    std::vector<std::uint32_t> values;
+    for (auto v : posting_deltas()) {
+        values.push_back(static_cast<std::uint32_t>(v));
+    }
+    values.resize(values.size() / 4 * 4);
+    neo::string_dynbuf_io out;
+    for (std::size_t i = 0; i < values.size(); i += 4) {
+        neo::buffer_encode(neo::group_varint_encoder(),
+                           out,
+                           neo::group_varint_group{values[i],
+                                                   values[i + 1],
+                                                   values[i + 2],
+                                                   values[i + 3]});
+    }
+    const auto bytes = std::string(out.read_area_view());
+
+    const std::size_t split = GENERATE(0u, 1u, 6u, 999u, 5003u);
+    REQUIRE(split <= bytes.size());
+    neo::group_varint_decoder  dec;
+    std::vector<std::uint32_t> got(values.size());
+    auto first = dec.decode_many(neo::as_buffer(bytes, split), got);
+    CHECK(first.bytes_read == split);
+    auto second = dec.decode_many(neo::as_buffer(bytes) + split,
+                                  std::span(got).subspan(first.count));
+    CHECK(first.count + second.count == values.size());
+    CHECK(second.bytes_read == bytes.size() - split);
+    CHECK(got == values);
+}
+
+TEST_CASE("Encode and decode Stream VByte") {
+    const std::vector<std::uint32_t> values = {1, 256, 65536, 1u << 24, 0xffff'ffffu, 2};
+    std::string control(neo::stream_vbyte_control_size(values.size()), '\0');
+    std::string data(neo::stream_vbyte_max_data_size(values.size()), '\0');
+    auto enc = neo::stream_vbyte_encode(values, neo::as_buffer(control), neo::as_buffer(data));
+    CHECK(enc.control_bytes == 2);
+    CHECK(enc.data_bytes == 15);
+    CHECK(enc.count == values.size());
+    // All control bytes are kept apart from all data bytes
+    CHECK(control == std::string("\xe4\x03", 2));
+    CHECK(data.substr(0, enc.data_bytes)
+          == std::string("\x01"
+                         "\x00\x01"
+                         "\x00\x00\x01"
+                         "\x00\x00\x00\x01"
+                         "\xff\xff\xff\xff"
+                         "\x02",
+                         15));
+
+    std::vector<std::uint32_t> got(values.size());
+    auto dec = neo::stream_vbyte_decode_many(neo::as_buffer(control),
+                                             neo::as_buffer(data, enc.data_bytes),
+                                             got);
+    CHECK(dec.control_bytes == 2);
+    CHECK(dec.data_bytes == 15);
+    CHECK(dec.count == values.size());
+    CHECK(got == values);
+}
+
+TEST_CASE("Batch-decode Stream VByte across segments") {
+    std::vector<std::uint32_t> values;
+    for (auto v : posting_deltas()) {
+        values.push_back(static_cast<std::uint32_t>(v));
+    }
+    // Not a multiple of four, so the final group is partial
+    values.resize(values.size() - 3);
+    std::string control(neo::stream_vbyte_control_size(values.size()), '\0');
+    std::string data(neo::stream_vbyte_max_data_size(values.size()), '\0');
+    auto enc = neo::stream_vbyte_encode(values, neo::as_buffer(control), neo::as_buffer(data));
+    data.resize(enc.data_bytes);
+
+    // The data stream arrives in two parts, split partway through a group
+    const std::size_t split = GENERATE(0u, 1u, 6u, 999u, 5003u);
+    REQUIRE(split <= data.size());
+    std::vector<std::uint32_t> got(values.size());
+    auto first = neo::stream_vbyte_decode_many(neo::as_buffer(control),
+                                               neo::as_buffer(data, split),
+                                               got);
+    CHECK(first.data_bytes <= split);
+    CHECK(first.count == first.control_bytes * 4);
+    auto second = neo::stream_vbyte_decode_many(neo::as_buffer(control) + first.control_bytes,
+                                                neo::as_buffer(data) + first.data_bytes,
+                                                std::span(got).subspan(first.count));
+    CHECK(first.count + second.count == values.size());
+    CHECK(first.control_bytes + second.control_bytes == control.size());
+    CHECK(first.data_bytes + second.data_bytes == data.size());
+    CHECK(got == values);
+}